@@ -189,9 +189,10 @@ def _check_mutex_args(parser, args, required=False):
 
 
 def _looks_like_search_input(filename):
-    with open(filename) as input_file:
-        first_line = next(input_file, "").rstrip()
-    return first_line == "begin_version"
+    with open(filename, "rb") as input_file:
+        first_line = next(input_file, b"").rstrip()
+    # Binary tasks written with "downward --dump-binary" start with this line.
+    return first_line in [b"begin_version", b"\x7fFDTASK"]
 
 
 def _set_components_automatically(parser, args):
@@ -117,6 +117,13 @@ def configs_optimal_extended():
         "pdb": [
             "--search",
             "astar(pdb())"],
+        "parallel_portfolio_blind_lmcut": [
+            "--search",
+            "parallel_portfolio([astar(blind()), astar(lmcut())],"
+            "stop_on_first_solution=false)"],
+        "astar_lmcut_symmetries": [
+            "--search",
+            "astar(lmcut(),symmetries=structural_symmetries())"],
     }
 
 
@@ -151,11 +158,25 @@ def configs_satisficing_extended():
         "ehc_ff": [
             "--search",
             "ehc(ff())"],
+        "ehc_ff_revisit_lookahead": [
+            "--search",
+            "let(h,ff(),ehc(h,preferred=[h],revisit_states=true,lookahead=10))"],
         # iterated
         "iterated_wa_ff": [
             "--search",
             "let(h,ff(),iterated([lazy_wastar([h],w=10), lazy_wastar([h],w=5), lazy_wastar([h],w=3),"
             "lazy_wastar([h],w=2), lazy_wastar([h],w=1)]))"],
+        # anytime wA*
+        "anytime_wastar_ff": [
+            "--search",
+            "anytime_wastar(ff(), weights=[5, 3, 2, 1])"],
+        "anytime_wastar_ff_restart": [
+            "--search",
+            "anytime_wastar(ff(), weights=[5, 3, 2, 1], restart=true)"],
+        # parallel portfolio
+        "parallel_portfolio_ff_cg": [
+            "--search",
+            "parallel_portfolio([lazy_greedy([ff()]), eager_greedy([cg()])])"],
         # pareto open list
         "pareto_ff": [
             "--search",
@@ -73,10 +73,11 @@ fast_downward_plugin(
         search_statistics
         state_id
         state_registry
+        state_value_cache
         task_id
         task_proxy
 
-    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS CAUSAL_GRAPH COMPILED_TASK INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES WIDE_INT_HASH_SET
     CORE_PLUGIN
 )
 
@@ -122,6 +123,7 @@ fast_downward_plugin(
         utils/markup
         utils/math
         utils/memory
+        utils/parallel
         utils/rng
         utils/rng_options
         utils/strings
@@ -206,6 +208,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME WIDE_INT_HASH_SET
+    HELP "Hash set storing integers with 64-bit hashes that grows incrementally"
+    SOURCES
+        algorithms/wide_int_hash_set
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME INT_PACKER
     HELP "Greedy bin packing algorithm to pack integer variables with small domains tightly into memory"
@@ -242,6 +252,7 @@ fast_downward_plugin(
     NAME SEGMENTED_VECTOR
     HELP "Memory-friendly and vector-like data structure"
     SOURCES
+        algorithms/segment_arena
         algorithms/segmented_vector
     DEPENDENCY_ONLY
 )
@@ -423,7 +434,7 @@ fast_downward_plugin(
     HELP "Eager search"
     SOURCES
         search_algorithms/eager_search
-    DEPENDS NULL_PRUNING_METHOD ORDERED_SET SUCCESSOR_GENERATOR
+    DEPENDS NULL_PRUNING_METHOD ORDERED_SET STRUCTURAL_SYMMETRIES SUCCESSOR_GENERATOR
     DEPENDENCY_ONLY
 )
 
@@ -491,6 +502,13 @@ fast_downward_plugin(
     DEPENDS G_EVALUATOR ORDERED_SET PREF_EVALUATOR SEARCH_COMMON SUCCESSOR_GENERATOR
 )
 
+fast_downward_plugin(
+    NAME ANYTIME_SEARCH
+    HELP "Anytime weighted A* search (ARA* and RWA*)"
+    SOURCES
+        search_algorithms/anytime_search
+)
+
 fast_downward_plugin(
     NAME ITERATED_SEARCH
     HELP "Iterated search"
@@ -498,6 +516,13 @@ fast_downward_plugin(
         search_algorithms/iterated_search
 )
 
+fast_downward_plugin(
+    NAME PARALLEL_PORTFOLIO
+    HELP "Parallel portfolio of search algorithms"
+    SOURCES
+        search_algorithms/parallel_portfolio
+)
+
 fast_downward_plugin(
     NAME LAZY_SEARCH
     HELP "Lazy search"
@@ -639,6 +664,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME COMPILED_TASK
+    HELP "Snapshot of the operators of a task in contiguous arrays"
+    SOURCES
+        task_utils/compiled_task
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME SAMPLING
     HELP "Sampling"
@@ -687,7 +720,9 @@ fast_downward_plugin(
         cartesian_abstractions/cartesian_set
         cartesian_abstractions/cegar
         cartesian_abstractions/cost_saturation
+        cartesian_abstractions/decision_diagram
         cartesian_abstractions/refinement_hierarchy
+        cartesian_abstractions/shortest_paths
         cartesian_abstractions/split_selector
         cartesian_abstractions/subtask_generators
         cartesian_abstractions/transition
@@ -825,6 +860,7 @@ fast_downward_plugin(
     HELP "Plugin containing the code for potential heuristics"
     SOURCES
         potentials/diverse_potential_heuristics
+        potentials/potential_ensemble
         potentials/potential_function
         potentials/potential_heuristic
         potentials/potential_max_heuristic
@@ -836,6 +872,23 @@ fast_downward_plugin(
     DEPENDS LP_SOLVER SAMPLING SUCCESSOR_GENERATOR TASK_PROPERTIES
 )
 
+fast_downward_plugin(
+    NAME STRUCTURAL_SYMMETRIES
+    HELP "Structural symmetries for orbit search"
+    SOURCES
+        structural_symmetries/structural_symmetries
+    DEPENDS GRAPH_AUTOMORPHISMS TASK_PROPERTIES
+    DEPENDENCY_ONLY
+)
+
+fast_downward_plugin(
+    NAME GRAPH_AUTOMORPHISMS
+    HELP "Computation of automorphisms of vertex-colored graphs"
+    SOURCES
+        algorithms/graph_automorphisms
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME SCCS
     HELP "Algorithm to compute the strongly connected components (SCCs) of a "
@@ -0,0 +1,342 @@
+#include "graph_automorphisms.h"
+
+#include "../utils/countdown_timer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <numeric>
+
+using namespace std;
+
+namespace graph_automorphisms {
+/*
+  Ordered partition of the vertices into cells. The vertices of each cell
+  are stored contiguously in elements, and each cell is identified by the
+  position of its first vertex.
+*/
+struct Partition {
+    vector<int> elements;
+    // position[v] is the index of v in elements.
+    vector<int> position;
+    // cell_of[v] is the cell containing v.
+    vector<int> cell_of;
+    // cell_end[cell] is one past the last position of the cell.
+    vector<int> cell_end;
+    int num_cells;
+
+    explicit Partition(const vector<int> &colors)
+        : elements(colors.size()),
+          position(colors.size()),
+          cell_of(colors.size()),
+          cell_end(colors.size()),
+          num_cells(0) {
+        iota(elements.begin(), elements.end(), 0);
+        stable_sort(elements.begin(), elements.end(), [&](int v1, int v2) {
+                        return colors[v1] < colors[v2];
+                    });
+        int num_vertices = elements.size();
+        int cell = 0;
+        for (int pos = 0; pos < num_vertices; ++pos) {
+            int v = elements[pos];
+            if (pos > 0 && colors[v] != colors[elements[pos - 1]]) {
+                cell_end[cell] = pos;
+                ++num_cells;
+                cell = pos;
+            }
+            position[v] = pos;
+            cell_of[v] = cell;
+        }
+        if (num_vertices > 0) {
+            cell_end[cell] = num_vertices;
+            ++num_cells;
+        }
+    }
+
+    bool is_discrete() const {
+        return num_cells == static_cast<int>(elements.size());
+    }
+
+    int get_first_non_singleton_cell() const {
+        int num_vertices = elements.size();
+        for (int cell = 0; cell < num_vertices; cell = cell_end[cell]) {
+            if (cell_end[cell] - cell > 1)
+                return cell;
+        }
+        return -1;
+    }
+};
+
+/*
+  Refines partitions to the coarsest equitable partition finer than them,
+  i.e., until all vertices in a cell have the same number of neighbors in
+  each cell. Cells are split in an order that only depends on the cell
+  structure, so isomorphic partitions are refined to isomorphic partitions.
+*/
+class Refiner {
+    const vector<vector<int>> &graph;
+    vector<int> counts;
+    vector<int> touched_vertices;
+    vector<int> touched_cells;
+    vector<bool> cell_is_touched;
+    vector<bool> in_queue;
+    deque<int> queue;
+    vector<int> splitter;
+    vector<int> pieces;
+
+    void enqueue(int cell) {
+        if (!in_queue[cell]) {
+            in_queue[cell] = true;
+            queue.push_back(cell);
+        }
+    }
+
+    void split_cell(Partition &partition, int cell) {
+        auto begin = partition.elements.begin() + cell;
+        auto end = partition.elements.begin() + partition.cell_end[cell];
+        int count = counts[*begin];
+        if (all_of(begin, end, [&](int v) {return counts[v] == count;}))
+            return;
+        sort(begin, end, [&](int v1, int v2) {
+                 return counts[v1] < counts[v2];
+             });
+
+        pieces.clear();
+        int cell_end = partition.cell_end[cell];
+        int piece = cell;
+        for (int pos = cell; pos < cell_end; ++pos) {
+            int v = partition.elements[pos];
+            if (pos > cell && counts[v] != counts[partition.elements[pos - 1]]) {
+                partition.cell_end[piece] = pos;
+                pieces.push_back(piece);
+                piece = pos;
+            }
+            partition.position[v] = pos;
+            partition.cell_of[v] = piece;
+        }
+        partition.cell_end[piece] = cell_end;
+        pieces.push_back(piece);
+        partition.num_cells += pieces.size() - 1;
+
+        /*
+          If the cell still has to be used as a splitter, all pieces have to
+          be used. Otherwise, it suffices to use all but one of them.
+        */
+        if (in_queue[cell]) {
+            for (size_t i = 1; i < pieces.size(); ++i) {
+                enqueue(pieces[i]);
+            }
+        } else {
+            int largest_piece = pieces[0];
+            for (int p : pieces) {
+                if (partition.cell_end[p] - p >
+                    partition.cell_end[largest_piece] - largest_piece) {
+                    largest_piece = p;
+                }
+            }
+            for (int p : pieces) {
+                if (p != largest_piece) {
+                    enqueue(p);
+                }
+            }
+        }
+    }
+
+    void refine(Partition &partition) {
+        while (!queue.empty() && !partition.is_discrete()) {
+            int cell = queue.front();
+            queue.pop_front();
+            in_queue[cell] = false;
+            splitter.assign(partition.elements.begin() + cell,
+                            partition.elements.begin() + partition.cell_end[cell]);
+            for (int v : splitter) {
+                for (int u : graph[v]) {
+                    if (counts[u]++ == 0) {
+                        touched_vertices.push_back(u);
+                        int touched_cell = partition.cell_of[u];
+                        if (!cell_is_touched[touched_cell]) {
+                            cell_is_touched[touched_cell] = true;
+                            touched_cells.push_back(touched_cell);
+                        }
+                    }
+                }
+            }
+            sort(touched_cells.begin(), touched_cells.end());
+            for (int touched_cell : touched_cells) {
+                cell_is_touched[touched_cell] = false;
+                split_cell(partition, touched_cell);
+            }
+            touched_cells.clear();
+            for (int u : touched_vertices) {
+                counts[u] = 0;
+            }
+            touched_vertices.clear();
+        }
+        while (!queue.empty()) {
+            in_queue[queue.front()] = false;
+            queue.pop_front();
+        }
+    }
+
+public:
+    explicit Refiner(const vector<vector<int>> &graph)
+        : graph(graph),
+          counts(graph.size(), 0),
+          cell_is_touched(graph.size(), false),
+          in_queue(graph.size(), false) {
+    }
+
+    void refine_all_cells(Partition &partition) {
+        int num_vertices = partition.elements.size();
+        for (int cell = 0; cell < num_vertices; cell = partition.cell_end[cell]) {
+            enqueue(cell);
+        }
+        refine(partition);
+    }
+
+    // Move v into a new singleton cell in front of its cell and refine.
+    void individualize_and_refine(Partition &partition, int v) {
+        int cell = partition.cell_of[v];
+        int cell_end = partition.cell_end[cell];
+        assert(cell_end - cell > 1);
+        int first = partition.elements[cell];
+        int pos = partition.position[v];
+        swap(partition.elements[cell], partition.elements[pos]);
+        partition.position[first] = pos;
+        partition.position[v] = cell;
+        partition.cell_end[cell] = cell + 1;
+        partition.cell_end[cell + 1] = cell_end;
+        for (int p = cell + 1; p < cell_end; ++p) {
+            partition.cell_of[partition.elements[p]] = cell + 1;
+        }
+        ++partition.num_cells;
+        enqueue(cell);
+        refine(partition);
+    }
+};
+
+static int find_orbit(vector<int> &orbit_parent, int v) {
+    while (orbit_parent[v] != v) {
+        orbit_parent[v] = orbit_parent[orbit_parent[v]];
+        v = orbit_parent[v];
+    }
+    return v;
+}
+
+// Relies on the neighbor lists being sorted.
+static bool is_automorphism(const vector<vector<int>> &graph,
+                            const vector<int> &colors,
+                            const vector<int> &permutation) {
+    int num_vertices = graph.size();
+    for (int v = 0; v < num_vertices; ++v) {
+        int image = permutation[v];
+        if (colors[v] != colors[image] ||
+            graph[v].size() != graph[image].size()) {
+            return false;
+        }
+        const vector<int> &image_neighbors = graph[image];
+        for (int u : graph[v]) {
+            if (!binary_search(image_neighbors.begin(), image_neighbors.end(),
+                               permutation[u])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+  Individualize vertex and then the first vertex of the first non-singleton
+  cell until the partition is discrete. Return false as soon as the cells
+  deviate from the first path, since the resulting leaf cannot induce an
+  automorphism in that case.
+*/
+static bool descend(Refiner &refiner, Partition &partition, int vertex,
+                    int level, const vector<int> &path_cells,
+                    const vector<int> &path_num_cells) {
+    refiner.individualize_and_refine(partition, vertex);
+    int depth = path_cells.size();
+    for (;;) {
+        if (partition.num_cells != path_num_cells[level])
+            return false;
+        if (++level == depth) {
+            assert(partition.is_discrete());
+            return true;
+        }
+        int cell = partition.get_first_non_singleton_cell();
+        if (cell != path_cells[level])
+            return false;
+        refiner.individualize_and_refine(partition, partition.elements[cell]);
+    }
+}
+
+vector<vector<int>> compute_automorphism_generators(
+    const vector<vector<int>> &graph,
+    const vector<int> &colors,
+    double max_time) {
+    utils::CountdownTimer timer(max_time);
+    int num_vertices = graph.size();
+    assert(colors.size() == graph.size());
+    vector<vector<int>> generators;
+
+    vector<vector<int>> sorted_graph(graph);
+    for (vector<int> &neighbors : sorted_graph) {
+        sort(neighbors.begin(), neighbors.end());
+    }
+
+    Refiner refiner(sorted_graph);
+    Partition root(colors);
+    refiner.refine_all_cells(root);
+
+    // Compute the first path and its leaf.
+    vector<int> path_vertices;
+    vector<int> path_cells;
+    vector<int> path_num_cells;
+    Partition first_leaf(root);
+    while (!first_leaf.is_discrete()) {
+        int cell = first_leaf.get_first_non_singleton_cell();
+        int vertex = first_leaf.elements[cell];
+        path_cells.push_back(cell);
+        path_vertices.push_back(vertex);
+        refiner.individualize_and_refine(first_leaf, vertex);
+        path_num_cells.push_back(first_leaf.num_cells);
+    }
+
+    vector<int> orbit_parent(num_vertices);
+    iota(orbit_parent.begin(), orbit_parent.end(), 0);
+    Partition current(root);
+    int depth = path_vertices.size();
+    for (int level = 0; level < depth; ++level) {
+        int cell = path_cells[level];
+        int vertex = path_vertices[level];
+        assert(current.cell_of[vertex] == cell);
+        vector<int> candidates(current.elements.begin() + cell,
+                               current.elements.begin() + current.cell_end[cell]);
+        for (int candidate : candidates) {
+            if (timer.is_expired())
+                return generators;
+            if (find_orbit(orbit_parent, candidate) ==
+                find_orbit(orbit_parent, vertex))
+                continue;
+            Partition leaf(current);
+            if (!descend(refiner, leaf, candidate, level, path_cells,
+                         path_num_cells))
+                continue;
+            vector<int> permutation(num_vertices);
+            for (int pos = 0; pos < num_vertices; ++pos) {
+                permutation[first_leaf.elements[pos]] = leaf.elements[pos];
+            }
+            if (is_automorphism(sorted_graph, colors, permutation)) {
+                for (int v = 0; v < num_vertices; ++v) {
+                    int orbit1 = find_orbit(orbit_parent, v);
+                    int orbit2 = find_orbit(orbit_parent, permutation[v]);
+                    orbit_parent[max(orbit1, orbit2)] = min(orbit1, orbit2);
+                }
+                generators.push_back(move(permutation));
+            }
+        }
+        refiner.individualize_and_refine(current, vertex);
+    }
+    return generators;
+}
+}
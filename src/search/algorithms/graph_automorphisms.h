@@ -0,0 +1,36 @@
+#ifndef ALGORITHMS_GRAPH_AUTOMORPHISMS_H
+#define ALGORITHMS_GRAPH_AUTOMORPHISMS_H
+
+#include <vector>
+
+namespace graph_automorphisms {
+/*
+  This function computes automorphisms of an undirected vertex-colored graph
+  with the individualization-refinement scheme used by tools like bliss or
+  saucy: we refine the coloring to an equitable partition, individualize the
+  first vertex of the first non-singleton cell and repeat until the partition
+  is discrete. For every other vertex w of a cell on this first path that is
+  not yet known to be in the same orbit as the individualized vertex, we
+  individualize w instead and descend along the same cells to another leaf.
+  The two leaves induce a permutation, which we keep if it is an automorphism.
+
+  Unlike the tools mentioned above, the search does not backtrack when such
+  a leaf does not induce an automorphism. The result therefore generates a
+  subgroup of the automorphism group, which might be a proper subgroup.
+  Every returned permutation is verified to be an automorphism, though.
+
+  Input: a graph represented as a vector of vectors, where graph[i] is the
+  vector of neighbors of vertex i (each edge is listed for both of its
+  vertices), and a color for each vertex. Automorphisms must map each vertex
+  to a vertex of the same color. The search stops early if it takes longer
+  than max_time seconds.
+
+  Output: a vector of non-trivial automorphisms, each given as a vector that
+  maps each vertex to its image.
+*/
+std::vector<std::vector<int>> compute_automorphism_generators(
+    const std::vector<std::vector<int>> &graph,
+    const std::vector<int> &colors,
+    double max_time);
+}
+#endif
@@ -1,6 +1,8 @@
 #include "int_packer.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 
 using namespace std;
 
@@ -29,59 +31,65 @@ static int get_bit_size_for_range(int range) {
     return num_bits;
 }
 
-class IntPacker::VariableInfo {
-    int range;
-    int bin_index;
-    int shift;
-    Bin read_mask;
-    Bin clear_mask;
-public:
-    VariableInfo(int range_, int bin_index_, int shift_)
-        : range(range_),
-          bin_index(bin_index_),
-          shift(shift_) {
-        int bit_size = get_bit_size_for_range(range);
-        read_mask = get_bit_mask(shift, shift + bit_size);
-        clear_mask = ~read_mask;
-    }
-
-    VariableInfo()
-        : bin_index(-1), shift(0), read_mask(0), clear_mask(0) {
-        // Default constructor needed for resize() in pack_bins.
-    }
-
-    ~VariableInfo() {
-    }
-
-    int get(const Bin *buffer) const {
-        return (buffer[bin_index] & read_mask) >> shift;
-    }
-
-    void set(Bin *buffer, int value) const {
-        assert(value >= 0 && value < range);
-        Bin &bin = buffer[bin_index];
-        bin = (bin & clear_mask) | (value << shift);
-    }
-};
+IntPacker::VariableInfo::VariableInfo(int range_, int bin_index_, int shift_)
+    : range(range_),
+      bin_index(bin_index_),
+      shift(shift_) {
+    int bit_size = get_bit_size_for_range(range);
+    read_mask = get_bit_mask(shift, shift + bit_size);
+    clear_mask = ~read_mask;
+}
 
 
 IntPacker::IntPacker(const vector<int> &ranges)
     : num_bins(0) {
-    pack_bins(ranges);
+    vector<int> var_order(ranges.size());
+    iota(var_order.begin(), var_order.end(), 0);
+    pack_bins(ranges, var_order, false);
 }
 
-IntPacker::~IntPacker() {
+IntPacker::IntPacker(const vector<int> &ranges, const vector<int> &frequencies)
+    : IntPacker(ranges) {
+    assert(frequencies.size() == ranges.size());
+    vector<int> var_order(ranges.size());
+    iota(var_order.begin(), var_order.end(), 0);
+    stable_sort(var_order.begin(), var_order.end(), [&](int var1, int var2) {
+                    return frequencies[var1] > frequencies[var2];
+                });
+
+    vector<VariableInfo> default_var_infos = move(var_infos);
+    int default_num_bins = num_bins;
+    var_infos.clear();
+    num_bins = 0;
+    pack_bins(ranges, var_order, true);
+    if (num_bins > default_num_bins) {
+        // Memory is more important than locality.
+        var_infos = move(default_var_infos);
+        num_bins = default_num_bins;
+    } else {
+        assert(hottest_variables_share_first_bin(ranges, var_order));
+    }
 }
 
-int IntPacker::get(const Bin *buffer, int var) const {
-    return var_infos[var].get(buffer);
+IntPacker::~IntPacker() {
 }
 
-void IntPacker::set(Bin *buffer, int var, int value) const {
-    var_infos[var].set(buffer, value);
+bool IntPacker::hottest_variables_share_first_bin(
+    const vector<int> &ranges, const vector<int> &var_order) const {
+    // The longest prefix of var_order that fits into one bin is in bin 0.
+    int used_bits = 0;
+    for (int var : var_order) {
+        used_bits += get_bit_size_for_range(ranges[var]);
+        if (used_bits > BITS_PER_BIN)
+            break;
+        if (var_infos[var].get_bin_index() != 0)
+            return false;
+    }
+    return true;
 }
 
-void IntPacker::pack_bins(const vector<int> &ranges) {
+void IntPacker::pack_bins(
+    const vector<int> &ranges, const vector<int> &var_order, bool keep_order) {
     assert(var_infos.empty());
 
     int num_vars = ranges.size();
@@ -90,25 +98,42 @@ void IntPacker::pack_bins(const vector<int> &ranges) {
     // bits_to_vars[k] contains all variables that require exactly k
     // bits to encode. Once a variable is packed into a bin, it is
     // removed from this index.
-    // Loop over the variables in reverse order to prefer variables with
-    // low indices in case of ties. This might increase cache-locality.
+    // Loop over the variables in reverse order to prefer variables
+    // early in var_order in case of ties. For the default order by
+    // index, this might increase cache-locality.
     vector<vector<int>> bits_to_vars(BITS_PER_BIN + 1);
-    for (int var = num_vars - 1; var >= 0; --var) {
+    for (auto it = var_order.rbegin(); it != var_order.rend(); ++it) {
+        int var = *it;
         int bits = get_bit_size_for_range(ranges[var]);
         assert(bits <= BITS_PER_BIN);
         bits_to_vars[bits].push_back(var);
     }
 
+    /*
+      If keep_order is true, we fill the bins with the variables in the
+      order of var_order instead of by size, so the variables early in
+      var_order end up together in the first bins.
+    */
+    vector<int> order_positions;
+    if (keep_order) {
+        order_positions.resize(num_vars);
+        for (int pos = 0; pos < num_vars; ++pos) {
+            order_positions[var_order[pos]] = pos;
+        }
+    }
+
     int packed_vars = 0;
     while (packed_vars != num_vars)
-        packed_vars += pack_one_bin(ranges, bits_to_vars);
+        packed_vars += pack_one_bin(ranges, bits_to_vars, order_positions);
 }
 
 int IntPacker::pack_one_bin(const vector<int> &ranges,
-                            vector<vector<int>> &bits_to_vars) {
+                            vector<vector<int>> &bits_to_vars,
+                            const vector<int> &order_positions) {
     // Returns the number of variables added to the bin. We pack each
     // bin with a greedy strategy, always adding the largest variable
-    // that still fits.
+    // that still fits. If order_positions is not empty, we instead always
+    // add the variable that still fits and comes first in the order.
 
     ++num_bins;
     int bin_index = num_bins - 1;
@@ -116,10 +141,24 @@ int IntPacker::pack_one_bin(const vector<int> &ranges,
     int num_vars_in_bin = 0;
 
     while (true) {
-        // Determine size of largest variable that still fits into the bin.
-        int bits = BITS_PER_BIN - used_bits;
-        while (bits > 0 && bits_to_vars[bits].empty())
-            --bits;
+        int free_bits = BITS_PER_BIN - used_bits;
+        int bits = 0;
+        if (order_positions.empty()) {
+            // Determine size of largest variable that still fits into the bin.
+            bits = free_bits;
+            while (bits > 0 && bits_to_vars[bits].empty())
+                --bits;
+        } else {
+            // The last variable of each list comes first in the order.
+            for (int size = 1; size <= free_bits; ++size) {
+                if (!bits_to_vars[size].empty() &&
+                    (bits == 0 ||
+                     order_positions[bits_to_vars[size].back()] <
+                     order_positions[bits_to_vars[bits].back()])) {
+                    bits = size;
+                }
+            }
+        }
 
         if (bits == 0) {
             // No more variables fit into the bin.
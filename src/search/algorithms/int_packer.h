@@ -1,6 +1,8 @@
 #ifndef ALGORITHMS_INT_PACKER_H
 #define ALGORITHMS_INT_PACKER_H
 
+#include <cassert>
+#include <cstdint>
 #include <vector>
 
 /*
@@ -16,20 +18,77 @@
   Uses a greedy bin-packing strategy to pack the variables, which
   should be close to optimal in most cases. (See code comments for
   details.)
+
+  Optionally, the packer takes a frequency for each variable, e.g., how
+  often operators change it. It then fills each bin with the most
+  frequent variables that still fit, so that frequent variables share
+  bins and successor generation touches fewer bins, as long as this does
+  not need more bins than the default packing.
+
+  Bins have 32 bits by default. With USE_64_BIT_STATE_BINS, they have 64
+  bits, which allows packing more variables that change together into
+  the same bin at the cost of padding for tasks with few variables.
 */
 namespace int_packer {
 class IntPacker {
-    class VariableInfo;
+public:
+#ifdef USE_64_BIT_STATE_BINS
+    typedef std::uint64_t Bin;
+#else
+    typedef unsigned int Bin;
+#endif
+
+private:
+    class VariableInfo {
+        int range;
+        int bin_index;
+        int shift;
+        Bin read_mask;
+        Bin clear_mask;
+    public:
+        VariableInfo(int range_, int bin_index_, int shift_);
+
+        VariableInfo()
+            : bin_index(-1), shift(0), read_mask(0), clear_mask(0) {
+            // Default constructor needed for resize() in pack_bins.
+        }
+
+        int get_bin_index() const {
+            return bin_index;
+        }
+
+        int get(const Bin *buffer) const {
+            return (buffer[bin_index] & read_mask) >> shift;
+        }
+
+        void set(Bin *buffer, int value) const {
+            assert(value >= 0 && value < range);
+            Bin &bin = buffer[bin_index];
+            bin = (bin & clear_mask) | (Bin(value) << shift);
+        }
+
+        Bin get_clear_mask() const {
+            return clear_mask;
+        }
+
+        Bin get_value_bits(int value) const {
+            assert(value >= 0 && value < range);
+            return Bin(value) << shift;
+        }
+    };
 
     std::vector<VariableInfo> var_infos;
     int num_bins;
 
     int pack_one_bin(const std::vector<int> &ranges,
-                     std::vector<std::vector<int>> &bits_to_vars);
-    void pack_bins(const std::vector<int> &ranges);
+                     std::vector<std::vector<int>> &bits_to_vars,
+                     const std::vector<int> &order_positions);
+    void pack_bins(const std::vector<int> &ranges,
+                   const std::vector<int> &var_order, bool keep_order);
+    bool hottest_variables_share_first_bin(
+        const std::vector<int> &ranges,
+        const std::vector<int> &var_order) const;
 public:
-    typedef unsigned int Bin;
-
     /*
       The constructor takes the range for each variable. The domain of
       variable i is {0, ..., ranges[i] - 1}. Because we are using signed
@@ -37,10 +96,50 @@ public:
       a variable can take up at most 31 bits if int is 32-bit.
     */
     explicit IntPacker(const std::vector<int> &ranges);
+
+    /*
+      Like the constructor above, but place variables with high frequencies
+      together in the first bins. frequencies[i] is the frequency of
+      variable i.
+    */
+    IntPacker(const std::vector<int> &ranges, const std::vector<int> &frequencies);
     ~IntPacker();
 
-    int get(const Bin *buffer, int var) const;
-    void set(Bin *buffer, int var, int value) const;
+    /*
+      A BinWrite sets the bits of some variables in one bin. Writes for
+      different variables in the same bin can be combined with add, so
+      setting several variables at once only touches each bin once.
+    */
+    struct BinWrite {
+        int bin_index;
+        Bin clear_mask;
+        Bin value_bits;
+
+        void add(const BinWrite &other) {
+            assert(bin_index == other.bin_index);
+            clear_mask &= other.clear_mask;
+            value_bits = (value_bits & other.clear_mask) | other.value_bits;
+        }
+
+        void apply(Bin *buffer) const {
+            Bin &bin = buffer[bin_index];
+            bin = (bin & clear_mask) | value_bits;
+        }
+    };
+
+    int get(const Bin *buffer, int var) const {
+        return var_infos[var].get(buffer);
+    }
+
+    void set(Bin *buffer, int var, int value) const {
+        var_infos[var].set(buffer, value);
+    }
+
+    BinWrite get_bin_write(int var, int value) const {
+        const VariableInfo &var_info = var_infos[var];
+        return BinWrite {var_info.get_bin_index(), var_info.get_clear_mask(),
+                         var_info.get_value_bits(value)};
+    }
 
     int get_num_bins() const {return num_bins;}
 };
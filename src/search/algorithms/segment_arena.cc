@@ -0,0 +1,235 @@
+#include "segment_arena.h"
+
+#include "../utils/language.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+namespace segment_arena {
+static const size_t HUGE_PAGE_BYTES = 2 * 1024 * 1024;
+static const size_t MAX_REGION_BYTES = 16 * HUGE_PAGE_BYTES;
+// Block sizes are powers of two from MIN_BLOCK_BYTES to MAX_BLOCK_BYTES.
+static const size_t MIN_BLOCK_BYTES = 64;
+// Larger blocks are not taken from the arena.
+static const size_t MAX_BLOCK_BYTES = HUGE_PAGE_BYTES / 2;
+static const int NUM_SIZE_CLASSES =
+    static_cast<int>(bit_width(MAX_BLOCK_BYTES) - bit_width(MIN_BLOCK_BYTES)) + 1;
+
+static size_t round_up(size_t num_bytes, size_t multiple) {
+    return (num_bytes + multiple - 1) / multiple * multiple;
+}
+
+// Return the smallest i such that MIN_BLOCK_BYTES << i is at least num_bytes.
+static int get_size_class(size_t num_bytes) {
+    assert(num_bytes > 0 && num_bytes <= MAX_BLOCK_BYTES);
+    int min_width = static_cast<int>(bit_width(MIN_BLOCK_BYTES - 1));
+    return max(static_cast<int>(bit_width(num_bytes - 1)), min_width) - min_width;
+}
+
+/*
+  Return a region of the given size, aligned to HUGE_PAGE_BYTES, or nullptr
+  if it cannot be reserved.
+*/
+static char *map_region(size_t num_bytes) {
+    assert(num_bytes % HUGE_PAGE_BYTES == 0);
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    void *region = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    region = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (region != MAP_FAILED) {
+        return static_cast<char *>(region);
+    }
+#endif
+    /*
+      Transparent huge pages require regions aligned to huge pages. Linux
+      usually aligns large mappings like this. Otherwise, we map an
+      additional huge page and unmap the unaligned parts.
+    */
+    region = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        return nullptr;
+    }
+    char *begin = static_cast<char *>(region);
+    if (reinterpret_cast<uintptr_t>(begin) % HUGE_PAGE_BYTES != 0) {
+        munmap(region, num_bytes);
+        size_t num_mapped_bytes = num_bytes + HUGE_PAGE_BYTES;
+        region = mmap(nullptr, num_mapped_bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED) {
+            return nullptr;
+        }
+        char *mapped_begin = static_cast<char *>(region);
+        char *mapped_end = mapped_begin + num_mapped_bytes;
+        begin = mapped_begin + round_up(
+            reinterpret_cast<uintptr_t>(mapped_begin), HUGE_PAGE_BYTES)
+            - reinterpret_cast<uintptr_t>(mapped_begin);
+        char *end = begin + num_bytes;
+        if (begin != mapped_begin) {
+            munmap(mapped_begin, begin - mapped_begin);
+        }
+        if (end != mapped_end) {
+            munmap(end, mapped_end - end);
+        }
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(begin, num_bytes, MADV_HUGEPAGE);
+#endif
+    return begin;
+#else
+    return static_cast<char *>(::operator new(num_bytes, nothrow));
+#endif
+}
+
+static void unmap_region(char *region, size_t num_bytes) {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    munmap(region, num_bytes);
+#else
+    utils::unused_variable(num_bytes);
+    ::operator delete(region);
+#endif
+}
+
+SegmentArena::ThreadRegion::~ThreadRegion() {
+    SegmentArena &arena = get_segment_arena();
+    lock_guard<std::mutex> lock(arena.mutex);
+    if (generation == arena.generation) {
+        arena.add_free_blocks(next_free, end);
+    }
+}
+
+SegmentArena::SegmentArena()
+    : spare_region(nullptr),
+      num_reserved_bytes(0),
+      free_lists(NUM_SIZE_CLASSES),
+      num_used_blocks(0),
+      generation(0) {
+}
+
+SegmentArena::ThreadRegion &SegmentArena::get_thread_region() {
+    thread_local ThreadRegion thread_region;
+    return thread_region;
+}
+
+void SegmentArena::reserve_thread_region(ThreadRegion &thread_region) {
+    if (thread_region.generation == generation) {
+        add_free_blocks(thread_region.next_free, thread_region.end);
+    }
+    thread_region.next_free = nullptr;
+    thread_region.end = nullptr;
+    thread_region.generation = generation;
+    if (spare_region) {
+        assert(regions.size() == 1 && regions[0].begin == spare_region);
+        thread_region.next_free = spare_region;
+        thread_region.end = spare_region + regions[0].num_bytes;
+        spare_region = nullptr;
+        return;
+    }
+    /*
+      Grow regions with the reserved memory to bound the unused part of the
+      last region by 1/16 of the reserved memory (or MAX_REGION_BYTES).
+    */
+    size_t num_bytes = clamp(
+        round_up(num_reserved_bytes / 16, HUGE_PAGE_BYTES),
+        HUGE_PAGE_BYTES, MAX_REGION_BYTES);
+    char *region = map_region(num_bytes);
+    while (!region) {
+        new_handler handler = get_new_handler();
+        if (!handler) {
+            throw bad_alloc();
+        }
+        handler();
+        region = map_region(num_bytes);
+    }
+    regions.push_back({region, num_bytes});
+    num_reserved_bytes += num_bytes;
+    thread_region.next_free = region;
+    thread_region.end = region + num_bytes;
+}
+
+void SegmentArena::add_free_blocks(char *begin, char *end) {
+    // Split the memory into blocks of decreasing size.
+    for (int size_class = NUM_SIZE_CLASSES - 1; size_class >= 0; --size_class) {
+        size_t block_bytes = MIN_BLOCK_BYTES << size_class;
+        while (static_cast<size_t>(end - begin) >= block_bytes) {
+            free_lists[size_class].push_back(begin);
+            begin += block_bytes;
+        }
+    }
+}
+
+void SegmentArena::release_regions() {
+    assert(num_used_blocks == 0);
+    for (vector<void *> &free_list : free_lists) {
+        vector<void *>().swap(free_list);
+    }
+    for (size_t i = 1; i < regions.size(); ++i) {
+        unmap_region(regions[i].begin, regions[i].num_bytes);
+    }
+    regions.resize(1);
+    spare_region = regions[0].begin;
+    num_reserved_bytes = regions[0].num_bytes;
+    // Threads must not take blocks from their released regions.
+    ++generation;
+}
+
+void *SegmentArena::allocate(size_t num_bytes) {
+    if (num_bytes > MAX_BLOCK_BYTES) {
+        return ::operator new(num_bytes);
+    }
+    int size_class = get_size_class(num_bytes);
+    size_t block_bytes = MIN_BLOCK_BYTES << size_class;
+    ThreadRegion &thread_region = get_thread_region();
+    lock_guard<std::mutex> lock(mutex);
+    void *block;
+    vector<void *> &free_list = free_lists[size_class];
+    if (!free_list.empty()) {
+        block = free_list.back();
+        free_list.pop_back();
+    } else {
+        if (thread_region.generation != generation ||
+            static_cast<size_t>(thread_region.end - thread_region.next_free) <
+            block_bytes) {
+            reserve_thread_region(thread_region);
+        }
+        block = thread_region.next_free;
+        thread_region.next_free += block_bytes;
+    }
+    ++num_used_blocks;
+    return block;
+}
+
+void SegmentArena::deallocate(void *block, size_t num_bytes) {
+    if (num_bytes > MAX_BLOCK_BYTES) {
+        ::operator delete(block);
+        return;
+    }
+    lock_guard<std::mutex> lock(mutex);
+    free_lists[get_size_class(num_bytes)].push_back(block);
+    assert(num_used_blocks > 0);
+    if (--num_used_blocks == 0) {
+        release_regions();
+    }
+}
+
+SegmentArena &get_segment_arena() {
+    /*
+      The arena is intentionally leaked: segments might be deallocated
+      after static objects have been destroyed, for example in objects
+      destroyed at program exit.
+    */
+    static SegmentArena *arena = new SegmentArena();
+    return *arena;
+}
+}
@@ -0,0 +1,113 @@
+#ifndef ALGORITHMS_SEGMENT_ARENA_H
+#define ALGORITHMS_SEGMENT_ARENA_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace segment_arena {
+/*
+  Memory arena for the segments of SegmentedVector and SegmentedArrayVector.
+
+  Segments are small (usually 8 KB), but searches can allocate millions of
+  them. Allocating them individually with operator new costs time and
+  spreads the data over many pages, which leads to many TLB misses. The
+  arena instead reserves large regions with mmap and hands out segments
+  from them. Regions are aligned to 2 MB and use huge pages: we first try
+  to map them with MAP_HUGETLB, which only succeeds if the system has
+  reserved huge pages, and otherwise ask for transparent huge pages with
+  madvise. Regions grow with the reserved memory (up to 32 MB), so small
+  searches only reserve little memory.
+
+  Block sizes are rounded up to powers of two, which wastes little memory
+  for segments. Deallocated blocks are kept in free lists by size and
+  reused, so segments of different entry sizes can reuse the same blocks,
+  e.g., when a search creates a new StateRegistry. When all blocks have been
+  deallocated, the arena returns its regions to the operating system. It
+  keeps the first region for later allocations, so code that repeatedly
+  allocates and frees a few segments does not map and unmap regions each
+  time.
+
+  All threads share one arena, so blocks deallocated by one thread can be
+  reused by all threads. Segments are only allocated every few thousand
+  bytes, so a mutex that guards the arena is cheap. New blocks come from a
+  region that belongs to the allocating thread, though. Linux places a page
+  on the NUMA node of the thread that first writes to it, so this keeps new
+  segments on the node of their thread in multi-threaded searches. When a
+  thread exits, the unused rest of its region goes to the free lists.
+
+  If no memory can be reserved, the arena calls the new-handler like
+  operator new does and throws std::bad_alloc if there is none.
+*/
+class SegmentArena {
+    struct Region {
+        char *begin;
+        std::size_t num_bytes;
+    };
+
+    // Region from which a thread takes new blocks.
+    struct ThreadRegion {
+        char *next_free = nullptr;
+        char *end = nullptr;
+        // Regions of earlier generations have been released.
+        int generation = -1;
+        ~ThreadRegion();
+    };
+
+    std::mutex mutex;
+    std::vector<Region> regions;
+    // Region kept after releasing the others, or nullptr if in use.
+    char *spare_region;
+    std::size_t num_reserved_bytes;
+    // free_lists[i] holds free blocks of MIN_BLOCK_BYTES << i bytes.
+    std::vector<std::vector<void *>> free_lists;
+    std::size_t num_used_blocks;
+    int generation;
+
+    static ThreadRegion &get_thread_region();
+    void reserve_thread_region(ThreadRegion &thread_region);
+    void add_free_blocks(char *begin, char *end);
+    void release_regions();
+public:
+    SegmentArena();
+    SegmentArena(const SegmentArena &) = delete;
+    SegmentArena &operator=(const SegmentArena &) = delete;
+
+    void *allocate(std::size_t num_bytes);
+    void deallocate(void *block, std::size_t num_bytes);
+};
+
+// Return the arena shared by all threads.
+extern SegmentArena &get_segment_arena();
+
+/*
+  Allocator that takes memory from the segment arena. This is the default
+  allocator of SegmentedVector and SegmentedArrayVector.
+*/
+template<class T>
+class SegmentAllocator {
+public:
+    using value_type = T;
+
+    SegmentAllocator() = default;
+
+    template<class U>
+    SegmentAllocator(const SegmentAllocator<U> &) {
+    }
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(get_segment_arena().allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *block, std::size_t n) {
+        get_segment_arena().deallocate(block, n * sizeof(T));
+    }
+
+    template<class U>
+    bool operator==(const SegmentAllocator<U> &) const {
+        return true;
+    }
+};
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef ALGORITHMS_SEGMENTED_VECTOR_H
 #define ALGORITHMS_SEGMENTED_VECTOR_H
 
+#include "segment_arena.h"
+
 #include <algorithm>
 #include <cassert>
 #include <iostream>
@@ -35,6 +37,9 @@
   storing many fixed-size arrays. It's essentially a variant of SegmentedVector
   where the size of the stored data is only known at runtime, not at compile
   time. Note that we do not support 0-length arrays (checked with an assertion).
+
+  By default, both classes take their segments from a segment_arena::SegmentArena,
+  which places them in large regions backed by huge pages (see segment_arena.h).
 */
 
 /*
@@ -49,7 +54,7 @@
 */
 
 namespace segmented_vector {
-template<class Entry, class Allocator = std::allocator<Entry>>
+template<class Entry, class Allocator = segment_arena::SegmentAllocator<Entry>>
 class SegmentedVector {
     using EntryAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
     static const size_t SEGMENT_BYTES = 8192;
@@ -148,7 +153,7 @@ public:
 };
 
 
-template<class Element, class Allocator = std::allocator<Element>>
+template<class Element, class Allocator = segment_arena::SegmentAllocator<Element>>
 class SegmentedArrayVector {
     using ElementAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Element>;
     static const size_t SEGMENT_BYTES = 8192;
@@ -2,6 +2,7 @@
 #define ALGORITHMS_SUBSCRIBER_H
 
 #include <cassert>
+#include <mutex>
 #include <unordered_set>
 
 /*
@@ -39,6 +40,13 @@ namespace subscriber {
 template<typename T>
 class SubscriberService;
 
+/*
+  Objects may subscribe to services and services may be destroyed in
+  different threads. This mutex guards the subscriber and service sets of
+  all objects. We never hold it while notifying a subscriber.
+*/
+inline std::mutex g_subscription_mutex;
+
 /*
   A Subscriber can subscribe to a SubscriberService and is notified if that
   service is destroyed. The template parameter T should be the class of the
@@ -55,7 +63,11 @@ public:
           We have to copy the services because unsubscribing erases the
           current service during the iteration.
         */
-        std::unordered_set<const SubscriberService<T> *> services_copy(services);
+        std::unordered_set<const SubscriberService<T> *> services_copy;
+        {
+            std::lock_guard<std::mutex> lock(g_subscription_mutex);
+            services_copy = services;
+        }
         for (const SubscriberService<T> *service : services_copy) {
             service->unsubscribe(this);
         }
@@ -80,7 +92,11 @@ public:
           We have to copy the subscribers because unsubscribing erases the
           current subscriber during the iteration.
         */
-        std::unordered_set<Subscriber<T> *> subscribers_copy(subscribers);
+        std::unordered_set<Subscriber<T> *> subscribers_copy;
+        {
+            std::lock_guard<std::mutex> lock(g_subscription_mutex);
+            subscribers_copy = subscribers;
+        }
         for (Subscriber<T> *subscriber : subscribers_copy) {
             subscriber->notify_service_destroyed(static_cast<T *>(this));
             unsubscribe(subscriber);
@@ -88,6 +104,7 @@ public:
     }
 
     void subscribe(Subscriber<T> *subscriber) const {
+        std::lock_guard<std::mutex> lock(g_subscription_mutex);
         assert(subscribers.find(subscriber) == subscribers.end());
         subscribers.insert(subscriber);
         assert(subscriber->services.find(this) == subscriber->services.end());
@@ -95,6 +112,7 @@ public:
     }
 
     void unsubscribe(Subscriber<T> *subscriber) const {
+        std::lock_guard<std::mutex> lock(g_subscription_mutex);
         assert(subscribers.find(subscriber) != subscribers.end());
         subscribers.erase(subscriber);
         assert(subscriber->services.find(this) != subscriber->services.end());
@@ -0,0 +1,281 @@
+#ifndef ALGORITHMS_WIDE_INT_HASH_SET_H
+#define ALGORITHMS_WIDE_INT_HASH_SET_H
+
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace wide_int_hash_set {
+/*
+  Hash set for storing integer keys, intended for very large sets such as
+  the registered states of long-running searches.
+
+  The interface matches int_hash_set::IntHashSet, but the hasher has to
+  return 64-bit hashes. The key type is a template parameter (64 bits by
+  default), and the number of slots is only limited by the available
+  memory.
+
+  Usage:
+
+  WideIntHashSet<MyHasher, MyEqualityTester> s(hasher, equal);
+  pair<int64_t, bool> result1 = s.insert(3);
+  assert(result1 == make_pair(3, true));
+  pair<int64_t, bool> result2 = s.insert(3);
+  assert(result2 == make_pair(3, false));
+
+  Implementation:
+
+  We use open addressing in the style of Swiss tables
+  (https://abseil.io/about/design/swisstables). Slots are organized in
+  groups of 16, and each slot has a control byte that is either "empty" or
+  holds the lowest 7 bits of the hash of its key. The remaining bits of the
+  hash determine the group where probing starts, and we probe groups
+  quadratically. Within a group, all control bytes are compared to the
+  7-bit hash at once (with SSE2 where available), so we only call the
+  equality tester for keys whose hash probably matches. Since keys are
+  never removed, a probe sequence ends at the first group with an empty
+  slot. We do not store hashes, so the hasher is called again for each key
+  when the set grows.
+
+  We keep the load factor below 7/8 and grow by doubling the number of
+  slots. Instead of moving all keys to the larger table at once, we keep the
+  old table and move a fixed number of its slots to the new table on each
+  insertion, which spreads the cost of a resize over the following
+  insertions. While keys are being moved, lookups check both tables. The
+  old table is not modified until all of its slots have been moved, so its
+  probe sequences stay intact.
+
+  Note on hash functions: like IntHashSet, this set requires hash functions
+  that distribute the values roughly uniformly over all 64 bits.
+*/
+template<typename Hasher, typename Equal, typename Key = std::int64_t>
+class WideIntHashSet {
+    static const std::size_t GROUP_SIZE = 16;
+    // Number of slots of the old table moved to the new table per insertion.
+    static const std::size_t MIGRATION_STEP = 4 * GROUP_SIZE;
+    static const std::uint8_t EMPTY = 0x80;
+
+    using GroupMask = std::uint32_t;
+
+    struct Table {
+        // One control byte and one key per slot.
+        std::vector<std::uint8_t> control;
+        std::vector<Key> keys;
+        std::size_t num_entries;
+
+        explicit Table(std::size_t capacity = 0)
+            : control(capacity, EMPTY),
+              keys(capacity),
+              num_entries(0) {
+            // Verify that the capacity is a multiple of GROUP_SIZE and a power of 2.
+            assert(capacity % GROUP_SIZE == 0);
+            assert((capacity & (capacity - 1)) == 0);
+        }
+
+        std::size_t capacity() const {
+            return keys.size();
+        }
+
+        bool empty() const {
+            return keys.empty();
+        }
+
+        bool needs_to_grow() const {
+            return num_entries >= capacity() / 8 * 7;
+        }
+
+        // Return the bit mask of the slots in the group with the given control byte.
+        GroupMask match(std::size_t group_start, std::uint8_t byte) const {
+            assert(group_start % GROUP_SIZE == 0);
+            const std::uint8_t *group = control.data() + group_start;
+#ifdef __SSE2__
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+            return _mm_movemask_epi8(
+                _mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(byte))));
+#else
+            GroupMask mask = 0;
+            for (std::size_t i = 0; i < GROUP_SIZE; ++i) {
+                if (group[i] == byte) {
+                    mask |= GroupMask(1) << i;
+                }
+            }
+            return mask;
+#endif
+        }
+
+        /*
+          Call visit(slot) for each slot on the probe sequence of the given
+          hash whose control byte matches the hash, until visit returns true
+          or a group with an empty slot has been checked. Return the first
+          empty slot of the last visited group, or capacity() if visit
+          returned true.
+        */
+        template<typename Visitor>
+        std::size_t probe(std::uint64_t hash, const Visitor &visit) const {
+            assert(!empty());
+            std::size_t group_mask = capacity() / GROUP_SIZE - 1;
+            std::size_t group = (hash >> 7) & group_mask;
+            std::uint8_t fingerprint = hash & 0x7f;
+            for (std::size_t step = 1;; ++step) {
+                std::size_t group_start = group * GROUP_SIZE;
+                for (GroupMask mask = match(group_start, fingerprint); mask;
+                     mask &= mask - 1) {
+                    if (visit(group_start + std::countr_zero(mask))) {
+                        return capacity();
+                    }
+                }
+                GroupMask empty_mask = match(group_start, EMPTY);
+                if (empty_mask) {
+                    return group_start + std::countr_zero(empty_mask);
+                }
+                /* Visiting the groups at triangular offsets reaches every
+                   group because the number of groups is a power of 2. */
+                assert(step <= group_mask);
+                group = (group + step) & group_mask;
+            }
+        }
+
+        void set(std::size_t slot, Key key, std::uint64_t hash) {
+            assert(control[slot] == EMPTY);
+            control[slot] = hash & 0x7f;
+            keys[slot] = key;
+            ++num_entries;
+        }
+    };
+
+    Hasher hasher;
+    Equal equal;
+    Table table;
+    // Table whose keys are being moved to table, or an empty table.
+    Table old_table;
+    // Slots of old_table before this index have been moved to table.
+    std::size_t next_slot_to_migrate;
+    std::size_t num_entries;
+    int num_resizes;
+
+    /*
+      Look for an equivalent key in the given table. If there is one, store
+      it in equal_key and return the capacity of the table. Otherwise, return
+      the empty slot where the key can be inserted.
+    */
+    std::size_t find(const Table &t, Key key, std::uint64_t hash,
+                     Key &equal_key) const {
+        return t.probe(hash, [&](std::size_t slot) {
+                           if (equal(t.keys[slot], key)) {
+                               equal_key = t.keys[slot];
+                               return true;
+                           }
+                           return false;
+                       });
+    }
+
+    void move_to_table(Key key) {
+        std::uint64_t hash = hasher(key);
+        std::size_t slot = table.probe(hash, [](std::size_t) {return false;});
+        table.set(slot, key, hash);
+    }
+
+    void migrate(std::size_t num_slots) {
+        std::size_t end = std::min(next_slot_to_migrate + num_slots,
+                                   old_table.capacity());
+        for (std::size_t slot = next_slot_to_migrate; slot < end; ++slot) {
+            if (old_table.control[slot] != EMPTY) {
+                move_to_table(old_table.keys[slot]);
+            }
+        }
+        next_slot_to_migrate = end;
+        if (next_slot_to_migrate == old_table.capacity()) {
+            assert(table.num_entries == num_entries);
+            old_table = Table();
+            next_slot_to_migrate = 0;
+        }
+    }
+
+    void enlarge() {
+        /* Moving MIGRATION_STEP >= 2 slots per insertion finishes the
+           previous resize before the new table is full again. */
+        if (!old_table.empty()) {
+            migrate(old_table.capacity());
+        }
+        old_table = std::move(table);
+        table = Table(old_table.capacity() * 2);
+        next_slot_to_migrate = 0;
+        ++num_resizes;
+    }
+
+public:
+    WideIntHashSet(const Hasher &hasher, const Equal &equal)
+        : hasher(hasher),
+          equal(equal),
+          table(GROUP_SIZE),
+          next_slot_to_migrate(0),
+          num_entries(0),
+          num_resizes(0) {
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+
+    /*
+      Insert a key into the hash set.
+
+      Return a pair whose first item is the given key, or an equivalent key
+      already contained in the hash set. The second item in the pair is a bool
+      indicating whether a new key was inserted into the hash set.
+    */
+    std::pair<Key, bool> insert(Key key) {
+        if (!old_table.empty()) {
+            migrate(MIGRATION_STEP);
+        }
+        std::uint64_t hash = hasher(key);
+        Key equal_key = key;
+        std::size_t slot = find(table, key, hash, equal_key);
+        if (slot == table.capacity()) {
+            return std::make_pair(equal_key, false);
+        }
+        if (!old_table.empty() &&
+            find(old_table, key, hash, equal_key) == old_table.capacity()) {
+            return std::make_pair(equal_key, false);
+        }
+        if (table.needs_to_grow()) {
+            enlarge();
+            slot = table.probe(hash, [](std::size_t) {return false;});
+        }
+        table.set(slot, key, hash);
+        ++num_entries;
+        return std::make_pair(key, true);
+    }
+
+    void print_statistics(utils::LogProxy &log) const {
+        std::size_t num_slots = table.capacity();
+        assert(num_slots != 0);
+        log << "Int hash set load factor: " << num_entries << "/"
+            << num_slots << " = "
+            << static_cast<double>(num_entries) / num_slots
+            << std::endl;
+        log << "Int hash set resizes: " << num_resizes << std::endl;
+    }
+};
+
+template<typename Hasher, typename Equal, typename Key>
+const std::size_t WideIntHashSet<Hasher, Equal, Key>::GROUP_SIZE;
+
+template<typename Hasher, typename Equal, typename Key>
+const std::size_t WideIntHashSet<Hasher, Equal, Key>::MIGRATION_STEP;
+
+template<typename Hasher, typename Equal, typename Key>
+const std::uint8_t WideIntHashSet<Hasher, Equal, Key>::EMPTY;
+}
+
+#endif
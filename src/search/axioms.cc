@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -50,6 +51,7 @@ AxiomEvaluator::AxiomEvaluator(const TaskProxy &task_proxy) {
                     int val = condition.get_value();
                     AxiomRule *rule = &rules[position];
                     axiom_literals[var_id][val].condition_of.push_back(rule);
+                    rule->conditions.push_back(condition.get_pair());
                 }
             }
         }
@@ -82,6 +84,17 @@ AxiomEvaluator::AxiomEvaluator(const TaskProxy &task_proxy) {
             else
                 default_values.emplace_back(-1);
         }
+
+        axiom_layers.reserve(variables.size());
+        for (VariableProxy var : variables) {
+            axiom_layers.push_back(var.get_axiom_layer());
+        }
+        rules_by_effect_var.resize(variables.size());
+        for (AxiomRule &rule : rules) {
+            rules_by_effect_var[rule.effect_var].push_back(&rule);
+        }
+        is_affected.resize(variables.size(), false);
+        affected_vars_by_layer.resize(last_layer + 1);
     }
 }
 
@@ -89,6 +102,8 @@ void AxiomEvaluator::evaluate(vector<int> &state) {
     if (!task_has_axioms)
         return;
 
+    lock_guard<mutex> lock(evaluation_mutex);
+
     assert(queue.empty());
     for (size_t var_id = 0; var_id < default_values.size(); ++var_id) {
         int default_value = default_values[var_id];
@@ -159,4 +174,124 @@ void AxiomEvaluator::evaluate(vector<int> &state) {
     }
 }
 
+/*
+  Mark the derived variables of layer min_layer or higher that have a rule
+  with a condition on var as affected.
+*/
+void AxiomEvaluator::mark_affected_vars(int var, int min_layer) {
+    for (const AxiomLiteral &literal : axiom_literals[var]) {
+        for (const AxiomRule *rule : literal.condition_of) {
+            int effect_var = rule->effect_var;
+            if (axiom_layers[effect_var] >= min_layer && !is_affected[effect_var]) {
+                is_affected[effect_var] = true;
+                affected_vars_by_layer[axiom_layers[effect_var]].push_back(effect_var);
+            }
+        }
+    }
+}
+
+/*
+  Recompute the affected variables of the given layer, assuming that all
+  lower layers have their final values. Conditions of rules of this layer
+  on other variables of this layer only require non-default values, since
+  negation by failure only refers to lower layers (see nbf_info_by_layer).
+  Therefore, we can reset the affected variables of this layer to their
+  default values and compute the least fixpoint of their rules as in
+  evaluate. The values of unaffected variables of this layer do not change
+  because none of their rules depends on a variable that changed or might
+  change.
+*/
+void AxiomEvaluator::reevaluate_layer(vector<int> &state, int layer) {
+    vector<int> &affected_vars = affected_vars_by_layer[layer];
+    // Close the affected variables under dependencies within the layer.
+    for (size_t i = 0; i < affected_vars.size(); ++i) {
+        for (const AxiomLiteral &literal : axiom_literals[affected_vars[i]]) {
+            for (const AxiomRule *rule : literal.condition_of) {
+                int effect_var = rule->effect_var;
+                if (axiom_layers[effect_var] == layer && !is_affected[effect_var]) {
+                    is_affected[effect_var] = true;
+                    affected_vars.push_back(effect_var);
+                }
+            }
+        }
+    }
+
+    old_values.clear();
+    for (int var : affected_vars) {
+        old_values.push_back(state[var]);
+        state[var] = default_values[var];
+    }
+
+    /*
+      Count the unsatisfied conditions of all rules before firing any of
+      them, so that conditions on affected variables count as unsatisfied.
+    */
+    for (int var : affected_vars) {
+        for (AxiomRule *rule : rules_by_effect_var[var]) {
+            rule->unsatisfied_conditions = 0;
+            for (const FactPair &condition : rule->conditions) {
+                if (state[condition.var] != condition.value) {
+                    ++rule->unsatisfied_conditions;
+                }
+            }
+        }
+    }
+    assert(queue.empty());
+    for (int var : affected_vars) {
+        for (const AxiomRule *rule : rules_by_effect_var[var]) {
+            if (rule->unsatisfied_conditions == 0 && state[var] != rule->effect_val) {
+                state[var] = rule->effect_val;
+                queue.push_back(rule->effect_literal);
+            }
+        }
+    }
+
+    // Apply Horn rules of affected variables.
+    while (!queue.empty()) {
+        const AxiomLiteral *curr_literal = queue.back();
+        queue.pop_back();
+        for (AxiomRule *rule : curr_literal->condition_of) {
+            int var_no = rule->effect_var;
+            if (axiom_layers[var_no] != layer || !is_affected[var_no])
+                continue;
+            if (--rule->unsatisfied_conditions == 0) {
+                int val = rule->effect_val;
+                if (state[var_no] != val) {
+                    state[var_no] = val;
+                    queue.push_back(rule->effect_literal);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < affected_vars.size(); ++i) {
+        is_affected[affected_vars[i]] = false;
+    }
+    for (size_t i = 0; i < affected_vars.size(); ++i) {
+        int var = affected_vars[i];
+        if (state[var] != old_values[i]) {
+            mark_affected_vars(var, layer + 1);
+        }
+    }
+    affected_vars.clear();
+}
+
+void AxiomEvaluator::evaluate_incrementally(
+    vector<int> &state, const vector<int> &changed_vars) {
+    if (!task_has_axioms)
+        return;
+
+    lock_guard<mutex> lock(evaluation_mutex);
+
+    for (int var : changed_vars) {
+        assert(default_values[var] == -1);
+        mark_affected_vars(var, 0);
+    }
+    for (size_t layer = 0; layer < affected_vars_by_layer.size(); ++layer) {
+        if (!affected_vars_by_layer[layer].empty()) {
+            reevaluate_layer(state, layer);
+        }
+    }
+}
+
 PerTaskInformation<AxiomEvaluator> g_axiom_evaluators;
@@ -5,6 +5,7 @@
 #include "task_proxy.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class AxiomEvaluator {
@@ -18,6 +19,8 @@ class AxiomEvaluator {
         int effect_var;
         int effect_val;
         AxiomLiteral *effect_literal;
+        // Only used for incremental evaluation.
+        std::vector<FactPair> conditions;
         AxiomRule(int cond_count, int eff_var, int eff_val, AxiomLiteral *eff_literal)
             : condition_count(cond_count), unsatisfied_conditions(cond_count),
               effect_var(eff_var), effect_val(eff_val), effect_literal(eff_literal) {
@@ -48,18 +51,46 @@ class AxiomEvaluator {
     */
     std::vector<int> default_values;
 
+    // Data for incremental evaluation.
+    std::vector<int> axiom_layers;
+    std::vector<std::vector<AxiomRule *>> rules_by_effect_var;
+    std::vector<bool> is_affected;
+    std::vector<std::vector<int>> affected_vars_by_layer;
+    std::vector<int> old_values;
+
     /*
       The queue is an instance variable rather than a local variable
       to reduce reallocation effort. See issue420.
     */
     std::vector<const AxiomLiteral *> queue;
 
+    /*
+      The evaluator is shared by all searches on the same task, which may
+      run in parallel (see parallel_portfolio). Since evaluation modifies
+      the data above, we evaluate one state at a time.
+    */
+    std::mutex evaluation_mutex;
+
     template<typename Values, typename Accessor>
     void evaluate_aux(Values &values, const Accessor &accessor);
+
+    void mark_affected_vars(int var, int min_layer);
+    void reevaluate_layer(std::vector<int> &state, int layer);
 public:
     explicit AxiomEvaluator(const TaskProxy &task_proxy);
 
     void evaluate(std::vector<int> &state);
+
+    /*
+      Like evaluate, but only recomputes the derived variables that can be
+      affected by a change of the given variables. The derived variables of
+      state must hold the values of a state that only differs from state in
+      changed_vars, e.g., the predecessor of a successor state. This is much
+      faster than evaluate if few variables change and each derived variable
+      depends on few other variables.
+    */
+    void evaluate_incrementally(
+        std::vector<int> &state, const std::vector<int> &changed_vars);
 };
 
 extern PerTaskInformation<AxiomEvaluator> g_axiom_evaluators;
@@ -32,6 +32,7 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         opts.get<double>("max_time"),
         opts.get<bool>("use_general_costs"),
         opts.get<PickSplit>("pick"),
+        opts.get<SearchStrategy>("search_strategy"),
         *rng,
         log);
     return cost_saturation.generate_heuristic_functions(
@@ -125,6 +126,10 @@ public:
             "use_general_costs",
             "allow negative costs in cost partitioning",
             "true");
+        add_option<SearchStrategy>(
+            "search_strategy",
+            "how to search for abstract solutions during refinement",
+            "incremental");
         Heuristic::add_options_to_feature(*this);
         utils::add_rng_options(*this);
 
@@ -167,4 +172,15 @@ static plugins::TypedEnumPlugin<PickSplit> _enum_plugin({
          "select an eligible variable with maximal h^add(s_0) value "
          "over all facts that need to be removed from the flaw state"}
     });
+
+static plugins::TypedEnumPlugin<SearchStrategy> _search_strategy_enum_plugin({
+        {"astar",
+         "run A* from the initial state after each refinement, using the "
+         "goal distance estimates from previous iterations as heuristic"},
+        {"incremental",
+         "maintain exact goal distances and a shortest path tree for all "
+         "abstract states and only repair them for the states whose "
+         "shortest path leads through the split state (see Speck and "
+         "Seipp, ICAPS 2022)"}
+    });
 }
@@ -1,8 +1,9 @@
 #include "cartesian_heuristic_function.h"
 
 #include "refinement_hierarchy.h"
+#include "utils.h"
 
-#include "../utils/collections.h"
+#include "../task_proxy.h"
 
 using namespace std;
 
@@ -10,13 +11,14 @@ namespace cartesian_abstractions {
 CartesianHeuristicFunction::CartesianHeuristicFunction(
     unique_ptr<RefinementHierarchy> &&hierarchy,
     vector<int> &&h_values)
-    : refinement_hierarchy(move(hierarchy)),
-      h_values(move(h_values)) {
+    : task(hierarchy->get_task()),
+      decision_diagram(
+          *hierarchy, get_domain_sizes(TaskProxy(*task)), h_values) {
 }
 
 int CartesianHeuristicFunction::get_value(const State &state) const {
-    int abstract_state_id = refinement_hierarchy->get_abstract_state_id(state);
-    assert(utils::in_bounds(abstract_state_id, h_values));
-    return h_values[abstract_state_id];
+    TaskProxy subtask_proxy(*task);
+    State subtask_state = subtask_proxy.convert_ancestor_state(state);
+    return decision_diagram.get_value(subtask_state.get_unpacked_values());
 }
 }
@@ -1,21 +1,24 @@
 #ifndef CARTESIAN_ABSTRACTIONS_CARTESIAN_HEURISTIC_FUNCTION_H
 #define CARTESIAN_ABSTRACTIONS_CARTESIAN_HEURISTIC_FUNCTION_H
 
+#include "decision_diagram.h"
+
 #include <memory>
 #include <vector>
 
+class AbstractTask;
 class State;
 
 namespace cartesian_abstractions {
 class RefinementHierarchy;
 /*
-  Store RefinementHierarchy and heuristic values for looking up abstract state
-  IDs and corresponding heuristic values efficiently.
+  Compile the RefinementHierarchy and the heuristic values into a
+  DecisionDiagram for looking up heuristic values efficiently.
 */
 class CartesianHeuristicFunction {
     // Avoid const to enable moving.
-    std::unique_ptr<RefinementHierarchy> refinement_hierarchy;
-    std::vector<int> h_values;
+    std::shared_ptr<AbstractTask> task;
+    DecisionDiagram decision_diagram;
 
 public:
     CartesianHeuristicFunction(
@@ -6,6 +6,7 @@
 #include "transition_system.h"
 #include "utils.h"
 
+#include "../task_utils/compiled_task.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/language.h"
 #include "../utils/logging.h"
@@ -84,6 +85,7 @@ CEGAR::CEGAR(
     int max_non_looping_transitions,
     double max_time,
     PickSplit pick,
+    SearchStrategy search_strategy,
     utils::RandomNumberGenerator &rng,
     utils::LogProxy &log)
     : task_proxy(*task),
@@ -91,8 +93,10 @@ CEGAR::CEGAR(
       max_states(max_states),
       max_non_looping_transitions(max_non_looping_transitions),
       split_selector(task, pick),
+      search_strategy(search_strategy),
       abstraction(utils::make_unique_ptr<Abstraction>(task, log)),
       abstract_search(task_properties::get_operator_costs(task_proxy)),
+      shortest_paths(task_properties::get_operator_costs(task_proxy)),
       timer(max_time),
       log(log) {
     assert(max_states >= 1);
@@ -167,6 +171,14 @@ bool CEGAR::may_keep_refining() const {
     return true;
 }
 
+int CEGAR::get_h_value(int state_id) const {
+    if (search_strategy == SearchStrategy::INCREMENTAL) {
+        return shortest_paths.get_goal_distance(state_id);
+    } else {
+        return abstract_search.get_h_value(state_id);
+    }
+}
+
 void CEGAR::refinement_loop(utils::RandomNumberGenerator &rng) {
     /*
       For landmark tasks we have to map all states in which the
@@ -182,13 +194,31 @@ void CEGAR::refinement_loop(utils::RandomNumberGenerator &rng) {
     utils::Timer find_trace_timer(false);
     utils::Timer find_flaw_timer(false);
     utils::Timer refine_timer(false);
+    utils::Timer update_goal_distances_timer(false);
+
+    const TransitionSystem &transition_system =
+        abstraction->get_transition_system();
+    if (search_strategy == SearchStrategy::INCREMENTAL) {
+        update_goal_distances_timer.resume();
+        shortest_paths.recompute(
+            transition_system.get_incoming_transitions(),
+            abstraction->get_goals());
+        update_goal_distances_timer.stop();
+    }
 
     while (may_keep_refining()) {
         find_trace_timer.resume();
-        unique_ptr<Solution> solution = abstract_search.find_solution(
-            abstraction->get_transition_system().get_outgoing_transitions(),
-            abstraction->get_initial_state().get_id(),
-            abstraction->get_goals());
+        unique_ptr<Solution> solution;
+        if (search_strategy == SearchStrategy::INCREMENTAL) {
+            solution = shortest_paths.extract_solution(
+                abstraction->get_initial_state().get_id(),
+                abstraction->get_goals());
+        } else {
+            solution = abstract_search.find_solution(
+                transition_system.get_outgoing_transitions(),
+                abstraction->get_initial_state().get_id(),
+                abstraction->get_goals());
+        }
         find_trace_timer.stop();
         if (!solution) {
             if (log.is_at_least_normal()) {
@@ -213,11 +243,23 @@ void CEGAR::refinement_loop(utils::RandomNumberGenerator &rng) {
         vector<Split> splits = flaw->get_possible_splits();
         const Split &split = split_selector.pick_split(abstract_state, splits, rng);
         auto new_state_ids = abstraction->refine(abstract_state, split.var_id, split.values);
-        // Since h-values only increase we can assign the h-value to the children.
-        abstract_search.copy_h_value_to_children(
-            state_id, new_state_ids.first, new_state_ids.second);
+        if (search_strategy == SearchStrategy::ASTAR) {
+            // Since h-values only increase we can assign the h-value to the children.
+            abstract_search.copy_h_value_to_children(
+                state_id, new_state_ids.first, new_state_ids.second);
+        }
         refine_timer.stop();
 
+        if (search_strategy == SearchStrategy::INCREMENTAL) {
+            update_goal_distances_timer.resume();
+            shortest_paths.update_incrementally(
+                transition_system.get_incoming_transitions(),
+                transition_system.get_outgoing_transitions(),
+                state_id, new_state_ids.first, new_state_ids.second,
+                abstraction->get_goals());
+            update_goal_distances_timer.stop();
+        }
+
         if (log.is_at_least_verbose() &&
             abstraction->get_num_states() % 1000 == 0) {
             log << abstraction->get_num_states() << "/" << max_states << " states, "
@@ -229,6 +271,10 @@ void CEGAR::refinement_loop(utils::RandomNumberGenerator &rng) {
         log << "Time for finding abstract traces: " << find_trace_timer << endl;
         log << "Time for finding flaws: " << find_flaw_timer << endl;
         log << "Time for splitting states: " << refine_timer << endl;
+        if (search_strategy == SearchStrategy::INCREMENTAL) {
+            log << "Time for updating goal distances: "
+                << update_goal_distances_timer << endl;
+        }
     }
 }
 
@@ -239,6 +285,8 @@ unique_ptr<Flaw> CEGAR::find_flaw(const Solution &solution) {
     const AbstractState *abstract_state = &abstraction->get_initial_state();
     State concrete_state = task_proxy.get_initial_state();
     assert(abstract_state->includes(concrete_state));
+    const compiled_task::CompiledTask &compiled_task =
+        compiled_task::g_compiled_tasks[task_proxy];
 
     if (log.is_at_least_debug())
         log << "  Initial abstract state: " << *abstract_state << endl;
@@ -252,7 +300,8 @@ unique_ptr<Flaw> CEGAR::find_flaw(const Solution &solution) {
             if (log.is_at_least_debug())
                 log << "  Move to " << *next_abstract_state << " with "
                     << op.get_name() << endl;
-            State next_concrete_state = concrete_state.get_unregistered_successor(op);
+            State next_concrete_state =
+                concrete_state.get_unregistered_successor(op, compiled_task);
             if (!next_abstract_state->includes(next_concrete_state)) {
                 if (log.is_at_least_debug())
                     log << "  Paths deviate." << endl;
@@ -290,7 +339,7 @@ void CEGAR::print_statistics() {
     if (log.is_at_least_normal()) {
         abstraction->print_statistics();
         int init_id = abstraction->get_initial_state().get_id();
-        log << "Initial h value: " << abstract_search.get_h_value(init_id) << endl;
+        log << "Initial h value: " << get_h_value(init_id) << endl;
         log << endl;
     }
 }
@@ -2,6 +2,7 @@
 #define CARTESIAN_ABSTRACTIONS_CEGAR_H
 
 #include "abstract_search.h"
+#include "shortest_paths.h"
 #include "split_selector.h"
 
 #include "../task_proxy.h"
@@ -19,12 +20,22 @@ namespace cartesian_abstractions {
 class Abstraction;
 struct Flaw;
 
+// How to find abstract solutions during refinement.
+enum class SearchStrategy {
+    /* Run A* over the whole abstraction after each split, using the goal
+       distance estimates from previous iterations as heuristic. */
+    ASTAR,
+    /* Maintain exact goal distances and a shortest path tree and repair
+       them only around the split state. */
+    INCREMENTAL
+};
+
 /*
   Iteratively refine a Cartesian abstraction with counterexample-guided
   abstraction refinement (CEGAR).
 
-  Store the abstraction, use AbstractSearch to find abstract solutions, find
-  flaws, use SplitSelector to select splits in case of ambiguities and break
+  Store the abstraction, use AbstractSearch or ShortestPaths to find abstract
+  solutions, find flaws, use SplitSelector to select splits in case of ambiguities and break
   spurious solutions.
 */
 class CEGAR {
@@ -33,9 +44,11 @@ class CEGAR {
     const int max_states;
     const int max_non_looping_transitions;
     const SplitSelector split_selector;
+    const SearchStrategy search_strategy;
 
     std::unique_ptr<Abstraction> abstraction;
     AbstractSearch abstract_search;
+    ShortestPaths shortest_paths;
 
     // Limit the time for building the abstraction.
     utils::CountdownTimer timer;
@@ -44,6 +57,8 @@ class CEGAR {
 
     bool may_keep_refining() const;
 
+    int get_h_value(int state_id) const;
+
     /*
       Map all states that can only be reached after reaching the goal
       fact to arbitrary goal states.
@@ -70,6 +85,7 @@ public:
         int max_non_looping_transitions,
         double max_time,
         PickSplit pick,
+        SearchStrategy search_strategy,
         utils::RandomNumberGenerator &rng,
         utils::LogProxy &log);
     ~CEGAR();
@@ -88,6 +88,7 @@ CostSaturation::CostSaturation(
     double max_time,
     bool use_general_costs,
     PickSplit pick_split,
+    SearchStrategy search_strategy,
     utils::RandomNumberGenerator &rng,
     utils::LogProxy &log)
     : subtask_generators(subtask_generators),
@@ -96,6 +97,7 @@ CostSaturation::CostSaturation(
       max_time(max_time),
       use_general_costs(use_general_costs),
       pick_split(pick_split),
+      search_strategy(search_strategy),
       rng(rng),
       log(log),
       num_abstractions(0),
@@ -203,6 +205,7 @@ void CostSaturation::build_abstractions(
                 rem_subtasks),
             timer.get_remaining_time() / rem_subtasks,
             pick_split,
+            search_strategy,
             rng,
             log);
 
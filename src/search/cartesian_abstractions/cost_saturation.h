@@ -1,6 +1,7 @@
 #ifndef CARTESIAN_ABSTRACTIONS_COST_SATURATION_H
 #define CARTESIAN_ABSTRACTIONS_COST_SATURATION_H
 
+#include "cegar.h"
 #include "refinement_hierarchy.h"
 #include "split_selector.h"
 
@@ -32,6 +33,7 @@ class CostSaturation {
     const double max_time;
     const bool use_general_costs;
     const PickSplit pick_split;
+    const SearchStrategy search_strategy;
     utils::RandomNumberGenerator &rng;
     utils::LogProxy &log;
 
@@ -60,6 +62,7 @@ public:
         double max_time,
         bool use_general_costs,
         PickSplit pick_split,
+        SearchStrategy search_strategy,
         utils::RandomNumberGenerator &rng,
         utils::LogProxy &log);
 
@@ -0,0 +1,106 @@
+#include "decision_diagram.h"
+
+#include "refinement_hierarchy.h"
+
+#include "../utils/collections.h"
+#include "../utils/hash.h"
+
+using namespace std;
+
+namespace cartesian_abstractions {
+/*
+  Return the first node reached from the given split node for the given value
+  of the node's variable that is either a leaf or splits another variable.
+*/
+static NodeID skip_nodes_for_same_variable(
+    const RefinementHierarchy &hierarchy, NodeID node_id, int value) {
+    int var = hierarchy.get_node(node_id).get_var();
+    while (true) {
+        const Node &node = hierarchy.get_node(node_id);
+        if (!node.is_split() || node.get_var() != var)
+            return node_id;
+        node_id = node.get_child(value);
+    }
+}
+
+DecisionDiagram::DecisionDiagram(
+    const RefinementHierarchy &hierarchy,
+    const vector<int> &domain_sizes,
+    const vector<int> &state_values)
+    : root(UNDEFINED) {
+    const int num_hierarchy_nodes = hierarchy.get_num_nodes();
+    /*
+      References to the compiled nodes for all hierarchy nodes that have been
+      compiled. We need a separate flag since all integers are valid
+      references.
+    */
+    vector<int> compiled_refs(num_hierarchy_nodes);
+    vector<bool> is_compiled(num_hierarchy_nodes, false);
+    utils::HashMap<vector<int>, int> unique_nodes;
+
+    // Compile the hierarchy bottom-up with an explicit stack.
+    vector<NodeID> stack = {0};
+    vector<NodeID> targets;
+    vector<int> key;
+    while (!stack.empty()) {
+        NodeID node_id = stack.back();
+        if (is_compiled[node_id]) {
+            stack.pop_back();
+            continue;
+        }
+        const Node &node = hierarchy.get_node(node_id);
+        if (!node.is_split()) {
+            int value = state_values[node.get_state_id()];
+            assert(value >= 0);
+            compiled_refs[node_id] = encode_leaf(value);
+            is_compiled[node_id] = true;
+            stack.pop_back();
+            continue;
+        }
+
+        int var = node.get_var();
+        assert(utils::in_bounds(var, domain_sizes));
+        int domain_size = domain_sizes[var];
+        targets.clear();
+        bool all_targets_compiled = true;
+        for (int value = 0; value < domain_size; ++value) {
+            NodeID target_id = skip_nodes_for_same_variable(hierarchy, node_id, value);
+            targets.push_back(target_id);
+            if (!is_compiled[target_id]) {
+                all_targets_compiled = false;
+                stack.push_back(target_id);
+            }
+        }
+        if (!all_targets_compiled)
+            continue;
+
+        key.clear();
+        key.push_back(var);
+        bool all_children_equal = true;
+        for (NodeID target_id : targets) {
+            int ref = compiled_refs[target_id];
+            if (ref != compiled_refs[targets[0]])
+                all_children_equal = false;
+            key.push_back(ref);
+        }
+        int ref;
+        if (all_children_equal) {
+            ref = compiled_refs[targets[0]];
+        } else {
+            auto it = unique_nodes.find(key);
+            if (it == unique_nodes.end()) {
+                ref = nodes.size();
+                nodes.insert(nodes.end(), key.begin(), key.end());
+                unique_nodes.emplace(key, ref);
+            } else {
+                ref = it->second;
+            }
+        }
+        compiled_refs[node_id] = ref;
+        is_compiled[node_id] = true;
+        stack.pop_back();
+    }
+    root = compiled_refs[0];
+    nodes.shrink_to_fit();
+}
+}
@@ -0,0 +1,66 @@
+#ifndef CARTESIAN_ABSTRACTIONS_DECISION_DIAGRAM_H
+#define CARTESIAN_ABSTRACTIONS_DECISION_DIAGRAM_H
+
+#include "types.h"
+
+#include <cassert>
+#include <vector>
+
+namespace cartesian_abstractions {
+class RefinementHierarchy;
+
+/*
+  Compact decision diagram that maps states to values of the abstract
+  states (usually goal distances). It is compiled from a
+  RefinementHierarchy and allows looking up values without chasing
+  pointers through the binary split nodes of the hierarchy.
+
+  Each inner node tests a single variable and has one child for each
+  value of the variable. All chains of hierarchy nodes splitting the
+  same variable (including helper nodes) are collapsed into one such
+  node. Nodes with the same variable and children are shared, and nodes
+  whose children are all identical are skipped. Leaves only store the
+  value, so all abstract states with the same value share one leaf.
+
+  All inner nodes live in one contiguous array. A node at position i
+  stores its variable at nodes[i] followed by the references to its
+  children, so a node for a variable with domain size d takes d + 1
+  entries. References to inner nodes are non-negative positions in
+  the array and references to leaves are the bitwise complements of
+  the leaf values.
+
+  A lookup reads one array entry per variable change along the path
+  instead of visiting one hierarchy node per split.
+*/
+class DecisionDiagram {
+    std::vector<int> nodes;
+    int root;
+
+    static int encode_leaf(int value) {
+        return ~value;
+    }
+
+    static int decode_leaf(int ref) {
+        return ~ref;
+    }
+
+public:
+    DecisionDiagram(
+        const RefinementHierarchy &hierarchy,
+        const std::vector<int> &domain_sizes,
+        const std::vector<int> &state_values);
+
+    int get_value(const std::vector<int> &state) const {
+        int ref = root;
+        while (ref >= 0) {
+            assert(ref < static_cast<int>(nodes.size()));
+            int var = nodes[ref];
+            assert(var >= 0 && var < static_cast<int>(state.size()));
+            ref = nodes[ref + 1 + state[var]];
+        }
+        return decode_leaf(ref);
+    }
+};
+}
+
+#endif
@@ -2,6 +2,8 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/collections.h"
+
 using namespace std;
 
 namespace cartesian_abstractions {
@@ -82,4 +84,13 @@ int RefinementHierarchy::get_abstract_state_id(const State &state) const {
     State subtask_state = subtask_proxy.convert_ancestor_state(state);
     return nodes[get_node_id(subtask_state)].get_state_id();
 }
+
+int RefinementHierarchy::get_num_nodes() const {
+    return nodes.size();
+}
+
+const Node &RefinementHierarchy::get_node(NodeID node_id) const {
+    assert(utils::in_bounds(node_id, nodes));
+    return nodes[node_id];
+}
 }
@@ -48,6 +48,13 @@ public:
         int left_state_id, int right_state_id);
 
     int get_abstract_state_id(const State &state) const;
+
+    const std::shared_ptr<AbstractTask> &get_task() const {
+        return task;
+    }
+
+    int get_num_nodes() const;
+    const Node &get_node(NodeID node_id) const;
 };
 
 
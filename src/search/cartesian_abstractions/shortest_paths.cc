@@ -0,0 +1,166 @@
+#include "shortest_paths.h"
+
+#include "../utils/collections.h"
+#include "../utils/memory.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace cartesian_abstractions {
+ShortestPaths::ShortestPaths(const vector<int> &operator_costs)
+    : operator_costs(operator_costs) {
+}
+
+int ShortestPaths::add_costs(int cost, int distance) const {
+    assert(cost >= 0 && distance >= 0);
+    if (cost == INF || distance == INF)
+        return INF;
+    return cost + distance;
+}
+
+void ShortestPaths::mark_dirty(int state_id) {
+    assert(utils::in_bounds(state_id, dirty));
+    assert(!dirty[state_id]);
+    dirty[state_id] = true;
+    dirty_states.push_back(state_id);
+}
+
+void ShortestPaths::dijkstra_from_open_states(const vector<Transitions> &in) {
+    /*
+      Only dirty states may change their goal distance. The goal distances
+      of all other states are final, so the search never has to leave the
+      set of dirty states.
+    */
+    while (!open_queue.empty()) {
+        pair<int, int> top_pair = open_queue.pop();
+        int old_distance = top_pair.first;
+        int state_id = top_pair.second;
+
+        const int distance = goal_distances[state_id];
+        assert(0 <= distance && distance < INF);
+        assert(distance <= old_distance);
+        if (distance < old_distance)
+            continue;
+        assert(utils::in_bounds(state_id, in));
+        for (const Transition &transition : in[state_id]) {
+            int op_id = transition.op_id;
+            int prev_id = transition.target_id;
+            if (!dirty[prev_id])
+                continue;
+            assert(utils::in_bounds(op_id, operator_costs));
+            int prev_distance = add_costs(operator_costs[op_id], distance);
+            if (prev_distance < goal_distances[prev_id]) {
+                goal_distances[prev_id] = prev_distance;
+                shortest_path[prev_id] = Transition(op_id, state_id);
+                open_queue.push(prev_distance, prev_id);
+            }
+        }
+    }
+    for (int state_id : dirty_states) {
+        dirty[state_id] = false;
+    }
+    dirty_states.clear();
+}
+
+void ShortestPaths::recompute(const vector<Transitions> &in, const Goals &goals) {
+    int num_states = in.size();
+    open_queue.clear();
+    goal_distances.assign(num_states, INF);
+    shortest_path.assign(num_states, Transition(UNDEFINED, UNDEFINED));
+    dirty.assign(num_states, false);
+    dirty_states.clear();
+    for (int state_id = 0; state_id < num_states; ++state_id) {
+        mark_dirty(state_id);
+    }
+    for (int goal_id : goals) {
+        goal_distances[goal_id] = 0;
+        open_queue.push(0, goal_id);
+    }
+    dijkstra_from_open_states(in);
+}
+
+void ShortestPaths::update_incrementally(
+    const vector<Transitions> &in,
+    const vector<Transitions> &out,
+    int v, int v1, int v2,
+    const Goals &goals) {
+    assert(v == v1);
+    assert(in.size() == out.size());
+    int num_states = in.size();
+    assert(v2 == num_states - 1);
+    goal_distances.resize(num_states, INF);
+    shortest_path.resize(num_states, Transition(UNDEFINED, UNDEFINED));
+    dirty.resize(num_states, false);
+    assert(dirty_states.empty());
+    assert(open_queue.empty());
+
+    /*
+      Collect all states whose path in the shortest path tree leads through
+      v. Transitions that led into v now lead into v1 or v2, but the stored
+      shortest paths still point to the old ID of v, which v1 reuses.
+    */
+    mark_dirty(v1);
+    mark_dirty(v2);
+    for (size_t i = 0; i < dirty_states.size(); ++i) {
+        int state_id = dirty_states[i];
+        int old_id = (state_id == v2) ? v : state_id;
+        for (const Transition &transition : in[state_id]) {
+            int prev_id = transition.target_id;
+            if (!dirty[prev_id] && shortest_path[prev_id].target_id == old_id) {
+                mark_dirty(prev_id);
+            }
+        }
+    }
+
+    /*
+      Seed the search with the best distances that dirty states can obtain
+      through transitions to clean states.
+    */
+    for (int state_id : dirty_states) {
+        goal_distances[state_id] = INF;
+        shortest_path[state_id] = Transition(UNDEFINED, UNDEFINED);
+        if (goals.count(state_id)) {
+            goal_distances[state_id] = 0;
+        } else {
+            for (const Transition &transition : out[state_id]) {
+                int succ_id = transition.target_id;
+                if (dirty[succ_id])
+                    continue;
+                int distance = add_costs(
+                    operator_costs[transition.op_id], goal_distances[succ_id]);
+                if (distance < goal_distances[state_id]) {
+                    goal_distances[state_id] = distance;
+                    shortest_path[state_id] = transition;
+                }
+            }
+        }
+        if (goal_distances[state_id] != INF) {
+            open_queue.push(goal_distances[state_id], state_id);
+        }
+    }
+    dijkstra_from_open_states(in);
+}
+
+unique_ptr<Solution> ShortestPaths::extract_solution(
+    int init_id, const Goals &goals) const {
+    if (get_goal_distance(init_id) == INF)
+        return nullptr;
+    unique_ptr<Solution> solution = utils::make_unique_ptr<Solution>();
+    int current_id = init_id;
+    while (!goals.count(current_id)) {
+        const Transition &transition = shortest_path[current_id];
+        assert(transition.op_id != UNDEFINED &&
+               transition.target_id != UNDEFINED);
+        assert(transition.target_id != current_id);
+        solution->push_back(transition);
+        current_id = transition.target_id;
+    }
+    return solution;
+}
+
+int ShortestPaths::get_goal_distance(int state_id) const {
+    assert(utils::in_bounds(state_id, goal_distances));
+    return goal_distances[state_id];
+}
+}
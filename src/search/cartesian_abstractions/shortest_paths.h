@@ -0,0 +1,65 @@
+#ifndef CARTESIAN_ABSTRACTIONS_SHORTEST_PATHS_H
+#define CARTESIAN_ABSTRACTIONS_SHORTEST_PATHS_H
+
+#include "abstract_search.h"
+#include "transition.h"
+#include "types.h"
+
+#include "../algorithms/priority_queues.h"
+
+#include <memory>
+#include <vector>
+
+namespace cartesian_abstractions {
+/*
+  Maintain exact goal distances and a shortest path tree towards the goal
+  for all abstract states and repair them incrementally after each split.
+
+  Since refining an abstraction can only increase goal distances, a state
+  keeps its goal distance if its path in the shortest path tree does not
+  pass through the split state. We therefore only recompute the distances
+  of the two new states and of the states whose path led through the split
+  state (see Speck and Seipp, ICAPS 2022). Abstract solutions are
+  extracted by following the tree from the initial state, so no search
+  over the full abstraction is needed during refinement.
+*/
+class ShortestPaths {
+    const std::vector<int> operator_costs;
+
+    // Keep data structures around to avoid reallocating them.
+    priority_queues::AdaptiveQueue<int> open_queue;
+    std::vector<int> goal_distances;
+    // First transition of a shortest path to a goal for each state.
+    std::vector<Transition> shortest_path;
+    std::vector<bool> dirty;
+    std::vector<int> dirty_states;
+
+    int add_costs(int cost, int distance) const;
+    void mark_dirty(int state_id);
+    void dijkstra_from_open_states(const std::vector<Transitions> &in);
+
+public:
+    explicit ShortestPaths(const std::vector<int> &operator_costs);
+
+    // Compute all goal distances and the shortest path tree from scratch.
+    void recompute(const std::vector<Transitions> &in, const Goals &goals);
+
+    /*
+      Update goal distances after state v has been split into v1 and v2.
+      The transition system must already be rewired. Like Abstraction,
+      we assume that v1 reuses the ID of v and v2 is a new state.
+    */
+    void update_incrementally(
+        const std::vector<Transitions> &in,
+        const std::vector<Transitions> &out,
+        int v, int v1, int v2,
+        const Goals &goals);
+
+    std::unique_ptr<Solution> extract_solution(
+        int init_id, const Goals &goals) const;
+
+    int get_goal_distance(int state_id) const;
+};
+}
+
+#endif
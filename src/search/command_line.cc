@@ -189,7 +189,12 @@ string usage(const string &progname) {
     return "usage: \n" +
            progname + " [OPTIONS] --search SEARCH < OUTPUT\n\n"
            "* SEARCH (SearchAlgorithm): configuration of the search algorithm\n"
-           "* OUTPUT (filename): translator output\n\n"
+           "* OUTPUT (filename): translator output or binary task\n\n"
+           "or: \n" +
+           progname + " --dump-binary FILENAME < OUTPUT\n\n"
+           "    Writes the task to FILENAME in a binary format, which can be\n"
+           "    used as input instead of the translator output and is much\n"
+           "    faster to load, and exits.\n\n"
            "Options:\n"
            "--help [NAME]\n"
            "    Prints help for all heuristics, open lists, etc. called NAME.\n"
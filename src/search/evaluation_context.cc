@@ -17,7 +17,8 @@ EvaluationContext::EvaluationContext(
       g_value(g_value),
       preferred(is_preferred),
       statistics(statistics),
-      calculate_preferred(calculate_preferred) {
+      calculate_preferred(calculate_preferred),
+      parent_state_id(StateID::no_state) {
 }
 
 
@@ -26,6 +27,7 @@ EvaluationContext::EvaluationContext(
     bool is_preferred, SearchStatistics *statistics, bool calculate_preferred)
     : EvaluationContext(other.cache, other.state, g_value, is_preferred,
                         statistics, calculate_preferred) {
+    parent_state_id = other.parent_state_id;
 }
 
 EvaluationContext::EvaluationContext(
@@ -73,6 +75,14 @@ bool EvaluationContext::is_preferred() const {
     return preferred;
 }
 
+void EvaluationContext::set_parent_state_id(StateID state_id) {
+    parent_state_id = state_id;
+}
+
+StateID EvaluationContext::get_parent_state_id() const {
+    return parent_state_id;
+}
+
 bool EvaluationContext::is_evaluator_value_infinite(Evaluator *eval) {
     return get_result(eval).is_infinite();
 }
@@ -47,6 +47,7 @@ class EvaluationContext {
     bool preferred;
     SearchStatistics *statistics;
     bool calculate_preferred;
+    StateID parent_state_id;
 
     static const int INVALID = -1;
 
@@ -94,6 +95,14 @@ public:
     int get_g_value() const;
     bool is_preferred() const;
 
+    /*
+      Searches may tell evaluators which state they generated the state from,
+      so that evaluators can reuse information they computed for the parent
+      (e.g., an LP basis). The parent is StateID::no_state if unknown.
+    */
+    void set_parent_state_id(StateID state_id);
+    StateID get_parent_state_id() const;
+
     /*
       Use get_evaluator_value() to query finite evaluator values. It
       is an error (guarded by an assertion) to call this method for
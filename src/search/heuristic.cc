@@ -7,10 +7,12 @@
 #include "task_utils/task_properties.h"
 #include "tasks/cost_adapted_task.h"
 #include "tasks/root_task.h"
+#include "utils/memory.h"
 
 #include <cassert>
 #include <cstdlib>
 #include <limits>
+#include <set>
 
 using namespace std;
 
@@ -20,15 +22,33 @@ Heuristic::Heuristic(const plugins::Options &opts)
       cache_evaluator_values(opts.get<bool>("cache_estimates")),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
       task_proxy(*task) {
+    int bounded_cache_memory = opts.get<int>("bounded_cache_memory");
+    if (bounded_cache_memory > 0) {
+        bounded_cache = utils::make_unique_ptr<StateValueCache>(
+            static_cast<size_t>(bounded_cache_memory) * 1024 * 1024);
+    }
 }
 
 Heuristic::~Heuristic() {
+    if (bounded_cache && log.is_at_least_normal()) {
+        log << "Bounded cache of " << get_description() << ": ";
+        bounded_cache->print_statistics(log);
+    }
 }
 
 void Heuristic::set_preferred(const OperatorProxy &op) {
     preferred_operators.insert(op.get_ancestor_operator_id(tasks::g_root_task.get()));
 }
 
+bool Heuristic::is_path_dependent() {
+    if (!path_dependent) {
+        set<Evaluator *> evals;
+        get_path_dependent_evaluators(evals);
+        path_dependent = evals.count(this) > 0;
+    }
+    return *path_dependent;
+}
+
 State Heuristic::convert_ancestor_state(const State &ancestor_state) const {
     return task_proxy.convert_ancestor_state(ancestor_state);
 }
@@ -41,6 +61,16 @@ void Heuristic::add_options_to_feature(plugins::Feature &feature) {
         " Currently, adapt_costs() and no_transform() are available.",
         "no_transform()");
     feature.add_option<bool>("cache_estimates", "cache heuristic estimates", "true");
+    feature.add_option<int>(
+        "bounded_cache_memory",
+        "memory in MiB for a bounded cache of heuristic estimates that "
+        "also works for unregistered states (e.g., in IDA*) and that is "
+        "used for all states whose estimates are not cached otherwise. "
+        "The cache evicts entries with the CLOCK strategy. Path-dependent "
+        "heuristics such as the landmark heuristics never use it. Use 0 "
+        "to disable it.",
+        "0",
+        plugins::Bounds("0", "infinity"));
 }
 
 EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
@@ -53,14 +83,28 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
 
     int heuristic = NO_VALUE;
 
-    if (!calculate_preferred && cache_evaluator_values &&
+    // PerStateInformation can only store values of registered states.
+    bool use_heuristic_cache = cache_evaluator_values && state.get_registry();
+    /*
+      Path-dependent heuristics mark entries of heuristic_cache as dirty
+      when their estimates change, which the bounded cache cannot do.
+    */
+    bool use_bounded_cache =
+        bounded_cache && !use_heuristic_cache && !is_path_dependent();
+
+    if (!calculate_preferred && use_heuristic_cache &&
         heuristic_cache[state].h != NO_VALUE && !heuristic_cache[state].dirty) {
         heuristic = heuristic_cache[state].h;
         result.set_count_evaluation(false);
+    } else if (!calculate_preferred && use_bounded_cache &&
+               bounded_cache->lookup(state, heuristic)) {
+        result.set_count_evaluation(false);
     } else {
         heuristic = compute_heuristic(state);
-        if (cache_evaluator_values) {
+        if (use_heuristic_cache) {
             heuristic_cache[state] = HEntry(heuristic, false);
+        } else if (use_bounded_cache) {
+            bounded_cache->insert(state, heuristic);
         }
         result.set_count_evaluation(true);
     }
@@ -100,7 +144,7 @@ bool Heuristic::does_cache_estimates() const {
 }
 
 bool Heuristic::is_estimate_cached(const State &state) const {
-    return heuristic_cache[state].h != NO_VALUE;
+    return state.get_registry() && heuristic_cache[state].h != NO_VALUE;
 }
 
 int Heuristic::get_cached_estimate(const State &state) const {
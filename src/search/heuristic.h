@@ -4,11 +4,13 @@
 #include "evaluator.h"
 #include "operator_id.h"
 #include "per_state_information.h"
+#include "state_value_cache.h"
 #include "task_proxy.h"
 
 #include "algorithms/ordered_set.h"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 class TaskProxy;
@@ -44,6 +46,15 @@ class Heuristic : public Evaluator {
     */
     ordered_set::OrderedSet<OperatorID> preferred_operators;
 
+    /*
+      Whether the heuristic is path-dependent (see
+      Evaluator::get_path_dependent_evaluators). We compute it on first use
+      because get_path_dependent_evaluators is virtual.
+    */
+    std::optional<bool> path_dependent;
+
+    bool is_path_dependent();
+
 protected:
     /*
       Cache for saving h values
@@ -54,6 +65,15 @@ protected:
     PerStateInformation<HEntry> heuristic_cache;
     bool cache_evaluator_values;
 
+    /*
+      Bounded cache for the h values of states that cannot be stored in
+      heuristic_cache, i.e., unregistered states and, if
+      cache_evaluator_values is false, all states. Only used if the
+      bounded_cache_memory option is positive and the heuristic is not
+      path-dependent, since entries cannot be marked as dirty.
+    */
+    std::unique_ptr<StateValueCache> bounded_cache;
+
     // Hold a reference to the task implementation and pass it to objects that need it.
     const std::shared_ptr<AbstractTask> task;
     // Use task_proxy to access task information.
@@ -60,6 +60,8 @@ Exploration::Exploration(const TaskProxy &task_proxy, utils::LogProxy &log)
         build_unary_operators(op);
     for (OperatorProxy axiom : axioms)
         build_unary_operators(axiom);
+
+    build_flat_representation();
 }
 
 void Exploration::build_unary_operators(const OperatorProxy &op) {
@@ -98,6 +100,52 @@ void Exploration::build_unary_operators(const OperatorProxy &op) {
     }
 }
 
+void Exploration::build_flat_representation() {
+    int num_propositions = 0;
+    for (const vector<Proposition> &var_propositions : propositions) {
+        proposition_offsets.push_back(num_propositions);
+        num_propositions += var_propositions.size();
+    }
+
+    int num_unary_ops = unary_operators.size();
+    vector<vector<int>> preconditions_by_unary_op(num_unary_ops);
+    triggered_op_starts.reserve(num_propositions + 1);
+    for (const vector<Proposition> &var_propositions : propositions) {
+        for (const Proposition &prop : var_propositions) {
+            int prop_id = get_proposition_id(prop.fact);
+            triggered_op_starts.push_back(triggered_ops.size());
+            for (const UnaryOperator *unary_op : prop.precondition_of) {
+                int unary_op_id = unary_op - unary_operators.data();
+                triggered_ops.push_back(unary_op_id);
+                preconditions_by_unary_op[unary_op_id].push_back(prop_id);
+            }
+        }
+    }
+    triggered_op_starts.push_back(triggered_ops.size());
+
+    unary_op_precondition_starts.reserve(num_unary_ops + 1);
+    for (int unary_op_id = 0; unary_op_id < num_unary_ops; ++unary_op_id) {
+        const UnaryOperator &unary_op = unary_operators[unary_op_id];
+        unary_op_effects.push_back(get_proposition_id(unary_op.effect->fact));
+        unary_op_precondition_starts.push_back(unary_op_preconditions.size());
+        const vector<int> &preconditions = preconditions_by_unary_op[unary_op_id];
+        unary_op_preconditions.insert(
+            unary_op_preconditions.end(), preconditions.begin(), preconditions.end());
+    }
+    unary_op_precondition_starts.push_back(unary_op_preconditions.size());
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    unconditional_effects.resize(operators.size());
+    for (OperatorProxy op : operators) {
+        for (EffectProxy effect : op.get_effects()) {
+            if (effect.get_conditions().empty()) {
+                unconditional_effects[op.get_id()].push_back(
+                    get_proposition_id(effect.get_fact().get_pair()));
+            }
+        }
+    }
+}
+
 /*
   This function initializes the priority queue and the information associated
   with propositions and unary operators for the relaxed exploration. Unary
@@ -226,4 +274,113 @@ vector<vector<bool>> Exploration::compute_relaxed_reachability(
     }
     return reached;
 }
+
+void Exploration::reach_lanes(int prop_id, Lanes lanes) {
+    Lanes new_lanes = lanes & ~reached_lanes[prop_id];
+    if (new_lanes) {
+        reached_lanes[prop_id] |= new_lanes;
+        if (!in_batch_queue[prop_id]) {
+            in_batch_queue[prop_id] = true;
+            batch_queue.push_back(prop_id);
+        }
+    }
+}
+
+vector<vector<vector<bool>>> Exploration::compute_relaxed_reachability_batch(
+    const vector<vector<FactPair>> &excluded_props,
+    const vector<vector<int>> &excluded_op_ids) {
+    int batch_size = excluded_props.size();
+    assert(static_cast<int>(excluded_op_ids.size()) == batch_size);
+    assert(batch_size <= MAX_BATCH_SIZE);
+    const Lanes all_lanes =
+        (batch_size == MAX_BATCH_SIZE) ? ~Lanes(0) : (Lanes(1) << batch_size) - 1;
+    int num_propositions = triggered_op_starts.size() - 1;
+    int num_operators = unconditional_effects.size();
+    int num_unary_ops = unary_op_effects.size();
+
+    /*
+      Compute the lanes in which unary operators are excluded with the same
+      rules as in setup_exploration_queue().
+    */
+    excluded_prop_lanes.assign(num_propositions, 0);
+    excluded_op_lanes.assign(num_operators, 0);
+    for (int lane = 0; lane < batch_size; ++lane) {
+        Lanes lane_bit = Lanes(1) << lane;
+        for (const FactPair &fact : excluded_props[lane]) {
+            excluded_prop_lanes[get_proposition_id(fact)] |= lane_bit;
+        }
+        for (int op_id : excluded_op_ids[lane]) {
+            assert(utils::in_bounds(op_id, excluded_op_lanes));
+            excluded_op_lanes[op_id] |= lane_bit;
+        }
+    }
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        for (int prop_id : unconditional_effects[op_id]) {
+            excluded_op_lanes[op_id] |= excluded_prop_lanes[prop_id];
+        }
+    }
+    allowed_unary_op_lanes.resize(num_unary_ops);
+    for (int unary_op_id = 0; unary_op_id < num_unary_ops; ++unary_op_id) {
+        Lanes excluded = excluded_prop_lanes[unary_op_effects[unary_op_id]];
+        int op_id = unary_operators[unary_op_id].op_or_axiom_id;
+        // Axioms (negative IDs) are never excluded explicitly.
+        if (op_id >= 0) {
+            excluded |= excluded_op_lanes[op_id];
+        }
+        allowed_unary_op_lanes[unary_op_id] = all_lanes & ~excluded;
+    }
+
+    reached_lanes.assign(num_propositions, 0);
+    in_batch_queue.assign(num_propositions, false);
+    batch_queue.clear();
+    for (FactProxy fact : task_proxy.get_initial_state()) {
+        reach_lanes(get_proposition_id(fact.get_pair()), all_lanes);
+    }
+    for (int unary_op_id = 0; unary_op_id < num_unary_ops; ++unary_op_id) {
+        if (unary_op_precondition_starts[unary_op_id] ==
+            unary_op_precondition_starts[unary_op_id + 1]) {
+            reach_lanes(unary_op_effects[unary_op_id],
+                        allowed_unary_op_lanes[unary_op_id]);
+        }
+    }
+
+    /*
+      A unary operator fires in all lanes in which it is allowed and all of
+      its preconditions are reached. Since reached lanes only ever grow, we
+      only need to reconsider the operators triggered by a proposition whose
+      lanes changed.
+    */
+    for (size_t queue_pos = 0; queue_pos < batch_queue.size(); ++queue_pos) {
+        int prop_id = batch_queue[queue_pos];
+        in_batch_queue[prop_id] = false;
+        for (int i = triggered_op_starts[prop_id];
+             i < triggered_op_starts[prop_id + 1]; ++i) {
+            int unary_op_id = triggered_ops[i];
+            Lanes lanes = allowed_unary_op_lanes[unary_op_id];
+            for (int j = unary_op_precondition_starts[unary_op_id];
+                 lanes && j < unary_op_precondition_starts[unary_op_id + 1]; ++j) {
+                lanes &= reached_lanes[unary_op_preconditions[j]];
+            }
+            if (lanes) {
+                reach_lanes(unary_op_effects[unary_op_id], lanes);
+            }
+        }
+    }
+
+    vector<vector<vector<bool>>> reached(batch_size);
+    for (int lane = 0; lane < batch_size; ++lane) {
+        Lanes lane_bit = Lanes(1) << lane;
+        vector<vector<bool>> &lane_reached = reached[lane];
+        lane_reached.resize(propositions.size());
+        for (size_t var_id = 0; var_id < propositions.size(); ++var_id) {
+            int num_values = propositions[var_id].size();
+            lane_reached[var_id].resize(num_values);
+            for (int value = 0; value < num_values; ++value) {
+                int prop_id = proposition_offsets[var_id] + value;
+                lane_reached[var_id][value] = reached_lanes[prop_id] & lane_bit;
+            }
+        }
+    }
+    return reached;
+}
 }
@@ -7,6 +7,7 @@
 
 #include "../algorithms/priority_queues.h"
 
+#include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -53,13 +54,48 @@ struct UnaryOperator {
 };
 
 class Exploration {
+    /*
+      In batched explorations, each proposition and unary operator has one
+      bit (lane) per exploration.
+    */
+    using Lanes = std::uint64_t;
+
     TaskProxy task_proxy;
 
     std::vector<UnaryOperator> unary_operators;
     std::vector<std::vector<Proposition>> propositions;
     std::deque<Proposition *> prop_queue;
 
+    /*
+      Flat copy of the propositions and unary operators above for batched
+      explorations. Propositions are numbered consecutively by variable and
+      value, unary operators keep their index in unary_operators, and
+      adjacency lists are stored in compressed form: the entries for index
+      i are stored at positions starts[i] to starts[i + 1] - 1.
+    */
+    std::vector<int> proposition_offsets;
+    std::vector<int> unary_op_effects;
+    std::vector<int> unary_op_precondition_starts;
+    std::vector<int> unary_op_preconditions;
+    std::vector<int> triggered_op_starts;
+    std::vector<int> triggered_ops;
+    // Propositions added unconditionally by each operator.
+    std::vector<std::vector<int>> unconditional_effects;
+
+    // Keep data structures for batched explorations to avoid reallocation.
+    std::vector<Lanes> excluded_prop_lanes;
+    std::vector<Lanes> excluded_op_lanes;
+    std::vector<Lanes> allowed_unary_op_lanes;
+    std::vector<Lanes> reached_lanes;
+    std::vector<bool> in_batch_queue;
+    std::vector<int> batch_queue;
+
     void build_unary_operators(const OperatorProxy &op);
+    void build_flat_representation();
+    int get_proposition_id(const FactPair &fact) const {
+        return proposition_offsets[fact.var] + fact.value;
+    }
+    void reach_lanes(int prop_id, Lanes lanes);
     void setup_exploration_queue(
         const State &state, const std::vector<FactPair> &excluded_props,
         const std::vector<int> &excluded_op_ids);
@@ -80,6 +116,20 @@ public:
     std::vector<std::vector<bool>> compute_relaxed_reachability(
         const std::vector<FactPair> &excluded_props,
         const std::vector<int> &excluded_op_ids);
+
+    // Maximum number of explorations in one batch.
+    static const int MAX_BATCH_SIZE = 64;
+
+    /*
+      Compute the same reachability information as
+      compute_relaxed_reachability() for up to MAX_BATCH_SIZE pairs of
+      exclusions (excluded_props[i], excluded_op_ids[i]) at once. The
+      explorations run in parallel with one bit per exploration in 64-bit
+      words, so a batch costs about as much as a single exploration.
+    */
+    std::vector<std::vector<std::vector<bool>>> compute_relaxed_reachability_batch(
+        const std::vector<std::vector<FactPair>> &excluded_props,
+        const std::vector<std::vector<int>> &excluded_op_ids);
 };
 }
 
@@ -142,14 +142,16 @@ LandmarkEfficientOptimalSharedCostAssignment::LandmarkEfficientOptimalSharedCost
     lp::LPSolverType solver_type)
     : LandmarkCostAssignment(operator_costs, graph),
       lp_solver(solver_type),
-      lp(build_initial_lp()) {
+      variable_upper_bounds(2 * graph.get_num_landmarks(), 0.0) {
+    lp_solver.load_problem(build_initial_lp());
 }
 
 lp::LinearProgram LandmarkEfficientOptimalSharedCostAssignment::build_initial_lp() {
-    /* The LP has one variable (column) per landmark and one
-       inequality (row) per operator. */
-    int num_cols = lm_graph.get_num_landmarks();
-    int num_rows = operator_costs.size();
+    /* The LP has two variables (columns) per landmark and one
+       inequality (row) per operator that achieves some landmark. */
+    int num_landmarks = lm_graph.get_num_landmarks();
+    int num_cols = 2 * num_landmarks;
+    int num_ops = operator_costs.size();
 
     named_vector::NamedVector<lp::LPVariable> lp_variables;
 
@@ -158,19 +160,53 @@ lp::LinearProgram LandmarkEfficientOptimalSharedCostAssignment::build_initial_lp
        Variable bounds are state-dependent; we initialize the range to {0}. */
     lp_variables.resize(num_cols, lp::LPVariable(0.0, 0.0, 1.0));
 
-    /* Set up lower bounds and upper bounds for the inequalities.
-       These simply say that the operator's total cost must fall
-       between 0 and the real operator cost. */
-    lp_constraints.resize(num_rows, lp::LPConstraint(0.0, 0.0));
-    for (size_t op_id = 0; op_id < operator_costs.size(); ++op_id) {
-        lp_constraints[op_id].set_lower_bound(0);
-        lp_constraints[op_id].set_upper_bound(operator_costs[op_id]);
+    /*
+      Define the constraint matrix. The constraints are of the form
+      cost(lm_i1) + cost(lm_i2) + ... + cost(lm_in) <= cost(o)
+      where lm_i1 ... lm_in are the landmarks for which o is a
+      relevant achiever. The first-achievers variable of a landmark
+      occurs in the rows of its first achievers and the possible-achievers
+      variable in the rows of its possible achievers. The lower and upper
+      bounds simply say that the operator's total cost must fall between 0
+      and the real operator cost.
+    */
+    vector<lp::LPConstraint> constraints_by_op(
+        num_ops, lp::LPConstraint(0.0, 0.0));
+    for (int op_id = 0; op_id < num_ops; ++op_id) {
+        constraints_by_op[op_id].set_upper_bound(operator_costs[op_id]);
+    }
+    for (int lm_id = 0; lm_id < num_landmarks; ++lm_id) {
+        const Landmark &landmark = lm_graph.get_node(lm_id)->get_landmark();
+        for (int op_id : landmark.first_achievers) {
+            assert(utils::in_bounds(op_id, constraints_by_op));
+            constraints_by_op[op_id].insert(
+                get_first_achievers_variable(lm_id), 1.0);
+        }
+        for (int op_id : landmark.possible_achievers) {
+            assert(utils::in_bounds(op_id, constraints_by_op));
+            constraints_by_op[op_id].insert(
+                get_possible_achievers_variable(lm_id), 1.0);
+        }
+    }
+
+    // Only use non-empty constraints in the LP. See issue443.
+    named_vector::NamedVector<lp::LPConstraint> lp_constraints;
+    for (lp::LPConstraint &constraint : constraints_by_op) {
+        if (!constraint.empty())
+            lp_constraints.push_back(move(constraint));
     }
 
-    /* Coefficients of constraints will be updated and recreated in each state.
-       We ignore them for the initial LP. */
     return lp::LinearProgram(lp::LPObjectiveSense::MAXIMIZE, move(lp_variables),
-                             {}, lp_solver.get_infinity());
+                             move(lp_constraints), lp_solver.get_infinity());
+}
+
+void LandmarkEfficientOptimalSharedCostAssignment::set_variable_upper_bound(
+    int var, double bound) {
+    assert(utils::in_bounds(var, variable_upper_bounds));
+    if (variable_upper_bounds[var] != bound) {
+        lp_solver.set_variable_upper_bound(var, bound);
+        variable_upper_bounds[var] = bound;
+    }
 }
 
 double LandmarkEfficientOptimalSharedCostAssignment::cost_sharing_h_value(
@@ -180,59 +216,27 @@ double LandmarkEfficientOptimalSharedCostAssignment::cost_sharing_h_value(
 
     /*
       Set up LP variable bounds for the landmarks.
-      The range of cost(lm_1) is {0} if the landmark is already
-      reached; otherwise it is [0, infinity].
-      The lower bounds are set to 0 in the constructor and never change.
-    */
-    int num_cols = lm_graph.get_num_landmarks();
-    for (int lm_id = 0; lm_id < num_cols; ++lm_id) {
-        if (lm_status_manager.get_landmark_status(lm_id) == lm_reached) {
-            lp.get_variables()[lm_id].upper_bound = 0;
-        } else {
-            lp.get_variables()[lm_id].upper_bound = lp_solver.get_infinity();
-        }
-    }
-
-    /*
-      Define the constraint matrix. The constraints are of the form
-      cost(lm_i1) + cost(lm_i2) + ... + cost(lm_in) <= cost(o)
-      where lm_i1 ... lm_in are the landmarks for which o is a
-      relevant achiever. Hence, we add a triple (op, lm, 1.0)
-      for each relevant achiever op of landmark lm, denoting that
-      in the op-th row and lm-th column, the matrix has a 1.0 entry.
+      The range of the variable for the relevant achievers of a landmark
+      (see get_achievers) is [0, infinity] and the range of all other
+      variables is {0}. In particular, both variables of a reached landmark
+      are fixed to 0. The lower bounds are 0 and never change.
     */
-    // Reuse previous constraint objects to save the effort of recreating them.
-    for (lp::LPConstraint &constraint : lp_constraints) {
-        constraint.clear();
-    }
-    for (int lm_id = 0; lm_id < num_cols; ++lm_id) {
+    int num_landmarks = lm_graph.get_num_landmarks();
+    double infinity = lp_solver.get_infinity();
+    for (int lm_id = 0; lm_id < num_landmarks; ++lm_id) {
         const Landmark &landmark = lm_graph.get_node(lm_id)->get_landmark();
         int lm_status = lm_status_manager.get_landmark_status(lm_id);
-        if (lm_status != lm_reached) {
-            const set<int> &achievers =
-                get_achievers(lm_status, landmark);
-            if (achievers.empty())
-                return numeric_limits<double>::max();
-            for (int op_id : achievers) {
-                assert(utils::in_bounds(op_id, lp_constraints));
-                lp_constraints[op_id].insert(lm_id, 1.0);
-            }
-        }
+        if (lm_status != lm_reached && get_achievers(lm_status, landmark).empty())
+            return numeric_limits<double>::max();
+        set_variable_upper_bound(
+            get_first_achievers_variable(lm_id),
+            lm_status == lm_not_reached ? infinity : 0.0);
+        set_variable_upper_bound(
+            get_possible_achievers_variable(lm_id),
+            lm_status == lm_needed_again ? infinity : 0.0);
     }
 
-    /* Copy non-empty constraints and use those in the LP.
-       This significantly speeds up the heuristic calculation. See issue443. */
-    // TODO: do not copy the data here.
-    lp.get_constraints().clear();
-    for (const lp::LPConstraint &constraint : lp_constraints) {
-        if (!constraint.empty())
-            lp.get_constraints().push_back(constraint);
-    }
-
-    // Load the problem into the LP solver.
-    lp_solver.load_problem(lp);
-
-    // Solve the linear program.
+    // Solve the linear program, starting from the previous basis.
     lp_solver.solve();
 
     assert(lp_solver.has_optimal_solution());
@@ -43,17 +43,26 @@ public:
 };
 
 class LandmarkEfficientOptimalSharedCostAssignment : public LandmarkCostAssignment {
-    lp::LPSolver lp_solver;
-    // We keep an additional copy of the constraints around to avoid some effort with recreating the vector (see issue443).
-    std::vector<lp::LPConstraint> lp_constraints;
     /*
-      We keep the vectors for LP variables and constraints around instead of
-      recreating them for every state. The actual constraints have to be
-      recreated because the coefficient matrix of the LP changes from state to
-      state. Reusing the vectors still saves some dynamic allocation overhead.
-     */
-    lp::LinearProgram lp;
+      The LP is loaded once and stays loaded for all states. Since the
+      relevant achievers of a landmark depend on whether it still has to be
+      reached for the first time or is needed again, each landmark has two
+      variables: one occurring in the constraints of its first achievers
+      and one occurring in the constraints of all its possible achievers.
+      For each state, we only change the variable bounds, which allows the
+      LP solver to warm-start from the basis of the previously solved LP.
+    */
+    lp::LPSolver lp_solver;
+    // Upper bounds of the variables in the loaded LP.
+    std::vector<double> variable_upper_bounds;
 
+    static int get_first_achievers_variable(int lm_id) {
+        return 2 * lm_id;
+    }
+    static int get_possible_achievers_variable(int lm_id) {
+        return 2 * lm_id + 1;
+    }
+    void set_variable_upper_bound(int var, double bound);
     lp::LinearProgram build_initial_lp();
 public:
     LandmarkEfficientOptimalSharedCostAssignment(
@@ -44,6 +44,7 @@ LandmarkFactory::LandmarkFactory(const plugins::Options &opts)
 */
 shared_ptr<LandmarkGraph> LandmarkFactory::compute_lm_graph(
     const shared_ptr<AbstractTask> &task) {
+    lock_guard<mutex> lock(lm_graph_mutex);
     if (lm_graph) {
         if (lm_graph_task != task.get()) {
             cerr << "LandmarkFactory was asked to compute landmark graphs for "
@@ -8,6 +8,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -65,6 +66,11 @@ protected:
 
 private:
     AbstractTask *lm_graph_task;
+    /*
+      Factories can be shared by several factories that lm_merged computes
+      concurrently, so we compute the landmark graph under a lock.
+    */
+    std::mutex lm_graph_mutex;
 
     virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task) = 0;
 
@@ -4,7 +4,10 @@
 #include "landmark_graph.h"
 
 #include "../plugins/plugin.h"
+#include "../utils/parallel.h"
 
+#include <algorithm>
+#include <atomic>
 #include <set>
 
 using namespace std;
@@ -15,7 +18,45 @@ class LandmarkNode;
 
 LandmarkFactoryMerged::LandmarkFactoryMerged(const plugins::Options &opts)
     : LandmarkFactory(opts),
-      lm_factories(opts.get_list<shared_ptr<LandmarkFactory>>("lm_factories")) {
+      lm_factories(opts.get_list<shared_ptr<LandmarkFactory>>("lm_factories")),
+      num_threads(opts.get<int>("num_threads")) {
+}
+
+/*
+  Compute the landmark graphs of all child factories with up to num_threads
+  threads. Factories cache their landmark graph, so afterwards
+  compute_lm_graph() returns the precomputed graphs without further work.
+  A factory that is shared by several children (at any depth) computes its
+  graph under a lock, so it is only computed once and the other threads
+  wait for it. Since the merged graph is only built after all threads
+  finished, it is the same as with sequential computation.
+*/
+void LandmarkFactoryMerged::compute_lm_graphs_concurrently(
+    const shared_ptr<AbstractTask> &task) {
+    // Skip repeated children, which would only wait for the first one.
+    vector<LandmarkFactory *> factories;
+    for (const shared_ptr<LandmarkFactory> &lm_factory : lm_factories) {
+        if (find(factories.begin(), factories.end(), lm_factory.get()) ==
+            factories.end()) {
+            factories.push_back(lm_factory.get());
+        }
+    }
+    int num_factories = factories.size();
+    int num_workers = min(num_threads, num_factories);
+    if (log.is_at_least_normal()) {
+        log << "Computing " << num_factories << " landmark graphs with "
+            << num_workers << " threads" << endl;
+    }
+
+    atomic<int> next_factory(0);
+    utils::run_in_parallel(num_workers, [&](int) {
+            while (true) {
+                int i = next_factory++;
+                if (i >= num_factories)
+                    break;
+                factories[i]->compute_lm_graph(task);
+            }
+        });
 }
 
 LandmarkNode *LandmarkFactoryMerged::get_matching_landmark(const Landmark &landmark) const {
@@ -44,6 +85,10 @@ void LandmarkFactoryMerged::generate_landmarks(
         log << "Merging " << lm_factories.size() << " landmark graphs" << endl;
     }
 
+    if (num_threads > 1) {
+        compute_lm_graphs_concurrently(task);
+    }
+
     vector<shared_ptr<LandmarkGraph>> lm_graphs;
     lm_graphs.reserve(lm_factories.size());
     achievers_calculated = true;
@@ -159,6 +204,14 @@ public:
             "Merges the landmarks and orderings from the parameter landmarks");
 
         add_list_option<shared_ptr<LandmarkFactory>>("lm_factories");
+        add_option<int>(
+            "num_threads",
+            "maximum number of threads used to compute the landmark graphs of "
+            "the child factories concurrently. With 1 thread, the factories "
+            "run one after another. The merged landmark graph does not depend "
+            "on this value.",
+            "1",
+            plugins::Bounds("1", "infinity"));
         add_landmark_factory_options_to_feature(*this);
 
         document_note(
@@ -169,6 +222,13 @@ public:
         document_note(
             "Note",
             "Does not currently support conjunctive landmarks");
+        document_note(
+            "Concurrency",
+            "Only the child factories run concurrently. Each factory, e.g., "
+            "lm_rhw or lm_hm, still computes its landmarks in a single "
+            "thread, so more threads only help if several child factories "
+            "are expensive. With num_threads > 1, the log output of the "
+            "child factories may interleave.");
 
         document_language_support(
             "conditional_effects",
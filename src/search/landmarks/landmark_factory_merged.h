@@ -8,7 +8,9 @@
 namespace landmarks {
 class LandmarkFactoryMerged : public LandmarkFactory {
     std::vector<std::shared_ptr<LandmarkFactory>> lm_factories;
+    int num_threads;
 
+    void compute_lm_graphs_concurrently(const std::shared_ptr<AbstractTask> &task);
     virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task) override;
     void postprocess();
     LandmarkNode *get_matching_landmark(const Landmark &landmark) const;
@@ -5,9 +5,54 @@
 
 #include "../task_utils/task_properties.h"
 
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
 using namespace std;
 
 namespace landmarks {
+using ReachabilityCallback = function<void (int, const vector<vector<bool>> &)>;
+
+/*
+  Run the explorations for all given exclusions in batches and pass the
+  index of each exploration together with its result to the callback.
+*/
+static void compute_relaxed_reachability_in_batches(
+    Exploration &exploration,
+    const vector<vector<FactPair>> &excluded_props,
+    const vector<vector<int>> &excluded_op_ids,
+    const ReachabilityCallback &callback) {
+    assert(excluded_props.size() == excluded_op_ids.size());
+    int num_explorations = excluded_props.size();
+    vector<vector<FactPair>> batch_props;
+    vector<vector<int>> batch_op_ids;
+    for (int start = 0; start < num_explorations;
+         start += Exploration::MAX_BATCH_SIZE) {
+        int end = min(start + Exploration::MAX_BATCH_SIZE, num_explorations);
+        batch_props.assign(excluded_props.begin() + start,
+                           excluded_props.begin() + end);
+        batch_op_ids.assign(excluded_op_ids.begin() + start,
+                            excluded_op_ids.begin() + end);
+        vector<vector<vector<bool>>> reached =
+            exploration.compute_relaxed_reachability_batch(
+                batch_props, batch_op_ids);
+        for (int i = start; i < end; ++i) {
+            callback(i, reached[i - start]);
+        }
+    }
+}
+
+static bool goals_reached(
+    const TaskProxy &task_proxy, const vector<vector<bool>> &reached) {
+    for (FactProxy goal : task_proxy.get_goals()) {
+        if (!reached[goal.get_variable().get_id()][goal.get_value()]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 LandmarkFactoryRelaxation::LandmarkFactoryRelaxation(const plugins::Options &opts)
     : LandmarkFactory(opts) {
 }
@@ -31,9 +76,21 @@ void LandmarkFactoryRelaxation::discard_noncausal_landmarks(
     // TODO: Check if the code works correctly in the presence of axioms.
     task_properties::verify_no_conditional_effects(task_proxy);
     int num_all_landmarks = lm_graph->get_num_landmarks();
+    vector<const Landmark *> landmarks;
+    for (const auto &node : lm_graph->get_nodes()) {
+        landmarks.push_back(&node->get_landmark());
+    }
+    vector<bool> is_causal =
+        are_causal_landmarks(task_proxy, exploration, landmarks);
+    unordered_set<const Landmark *> noncausal_landmarks;
+    for (size_t i = 0; i < landmarks.size(); ++i) {
+        if (!is_causal[i]) {
+            noncausal_landmarks.insert(landmarks[i]);
+        }
+    }
     lm_graph->remove_node_if(
-        [this, &task_proxy, &exploration](const LandmarkNode &node) {
-            return !is_causal_landmark(task_proxy, exploration, node.get_landmark());
+        [&noncausal_landmarks](const LandmarkNode &node) {
+            return noncausal_landmarks.count(&node.get_landmark());
         });
     int num_causal_landmarks = lm_graph->get_num_landmarks();
     if (log.is_at_least_normal()) {
@@ -42,38 +99,44 @@ void LandmarkFactoryRelaxation::discard_noncausal_landmarks(
     }
 }
 
-bool LandmarkFactoryRelaxation::is_causal_landmark(
+vector<bool> LandmarkFactoryRelaxation::are_causal_landmarks(
     const TaskProxy &task_proxy, Exploration &exploration,
-    const Landmark &landmark) const {
-    assert(!landmark.conjunctive);
-
-    if (landmark.is_true_in_goal)
-        return true;
-
-    vector<int> excluded_op_ids;
-    vector<FactPair> excluded_props;
-    for (OperatorProxy op : task_proxy.get_operators()) {
-        if (is_landmark_precondition(op, landmark)) {
-            excluded_op_ids.push_back(op.get_id());
+    const vector<const Landmark *> &landmarks) const {
+    int num_landmarks = landmarks.size();
+    vector<bool> is_causal(num_landmarks, true);
+    vector<int> tested_landmarks;
+    vector<vector<FactPair>> excluded_props;
+    vector<vector<int>> excluded_op_ids;
+    for (int i = 0; i < num_landmarks; ++i) {
+        const Landmark &landmark = *landmarks[i];
+        assert(!landmark.conjunctive);
+        if (landmark.is_true_in_goal)
+            continue;
+
+        tested_landmarks.push_back(i);
+        excluded_props.emplace_back();
+        vector<int> &op_ids = excluded_op_ids.emplace_back();
+        for (OperatorProxy op : task_proxy.get_operators()) {
+            if (is_landmark_precondition(op, landmark)) {
+                op_ids.push_back(op.get_id());
+            }
         }
     }
 
-    vector<vector<bool>> reached =
-        exploration.compute_relaxed_reachability(excluded_props,
-                                                 excluded_op_ids);
-
-    for (FactProxy goal : task_proxy.get_goals()) {
-        if (!reached[goal.get_variable().get_id()][goal.get_value()]) {
-            return true;
-        }
-    }
-    return false;
+    compute_relaxed_reachability_in_batches(
+        exploration, excluded_props, excluded_op_ids,
+        [&](int i, const vector<vector<bool>> &reached) {
+            is_causal[tested_landmarks[i]] = !goals_reached(task_proxy, reached);
+        });
+    return is_causal;
 }
 
 void LandmarkFactoryRelaxation::calc_achievers(
     const TaskProxy &task_proxy, Exploration &exploration) {
     assert(!achievers_calculated);
     VariablesProxy variables = task_proxy.get_variables();
+    vector<Landmark *> landmarks;
+    vector<vector<FactPair>> excluded_props;
     for (auto &lm_node : lm_graph->get_nodes()) {
         Landmark &landmark = lm_node->get_landmark();
         for (const FactPair &lm_fact : landmark.facts) {
@@ -83,33 +146,42 @@ void LandmarkFactoryRelaxation::calc_achievers(
             if (variables[lm_fact.var].is_derived())
                 landmark.is_derived = true;
         }
-
-        vector<vector<bool>> reached =
-            compute_relaxed_reachability(exploration, landmark);
-
-        for (int op_or_axom_id : landmark.possible_achievers) {
-            OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axom_id);
-
-            if (possibly_reaches_lm(op, reached, landmark)) {
-                landmark.first_achievers.insert(op_or_axom_id);
-            }
-        }
+        landmarks.push_back(&landmark);
+        excluded_props.emplace_back(landmark.facts.begin(), landmark.facts.end());
     }
+    vector<vector<int>> excluded_op_ids(landmarks.size());
+
+    compute_relaxed_reachability_in_batches(
+        exploration, excluded_props, excluded_op_ids,
+        [&](int i, const vector<vector<bool>> &reached) {
+            Landmark &landmark = *landmarks[i];
+            for (int op_or_axom_id : landmark.possible_achievers) {
+                OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axom_id);
+
+                if (possibly_reaches_lm(op, reached, landmark)) {
+                    landmark.first_achievers.insert(op_or_axom_id);
+                }
+            }
+        });
     achievers_calculated = true;
 }
 
-bool LandmarkFactoryRelaxation::relaxed_task_solvable(
+vector<bool> LandmarkFactoryRelaxation::relaxed_task_solvable(
     const TaskProxy &task_proxy, Exploration &exploration,
-    const Landmark &exclude) const {
-    vector<vector<bool>> reached = compute_relaxed_reachability(exploration,
-                                                                exclude);
-
-    for (FactProxy goal : task_proxy.get_goals()) {
-        if (!reached[goal.get_variable().get_id()][goal.get_value()]) {
-            return false;
-        }
+    const vector<const Landmark *> &excluded) const {
+    vector<vector<FactPair>> excluded_props;
+    for (const Landmark *landmark : excluded) {
+        excluded_props.emplace_back(landmark->facts.begin(), landmark->facts.end());
     }
-    return true;
+    vector<vector<int>> excluded_op_ids(excluded.size());
+
+    vector<bool> solvable(excluded.size());
+    compute_relaxed_reachability_in_batches(
+        exploration, excluded_props, excluded_op_ids,
+        [&](int i, const vector<vector<bool>> &reached) {
+            solvable[i] = goals_reached(task_proxy, reached);
+        });
+    return solvable;
 }
 
 vector<vector<bool>> LandmarkFactoryRelaxation::compute_relaxed_reachability(
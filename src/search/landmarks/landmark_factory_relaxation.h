@@ -11,12 +11,13 @@ protected:
     explicit LandmarkFactoryRelaxation(const plugins::Options &opts);
 
     /*
-      Test whether the relaxed planning task is solvable without
-      achieving the excluded landmark.
+      Test for each of the excluded landmarks whether the relaxed planning
+      task is solvable without achieving it. The tests are run in batches
+      of bit-parallel explorations.
     */
-    bool relaxed_task_solvable(const TaskProxy &task_proxy,
-                               Exploration &exploration,
-                               const Landmark &exclude) const;
+    std::vector<bool> relaxed_task_solvable(
+        const TaskProxy &task_proxy, Exploration &exploration,
+        const std::vector<const Landmark *> &excluded) const;
     /*
       Compute for each fact whether it is relaxed reachable without
       achieving the excluded landmark.
@@ -43,11 +44,12 @@ protected:
                                      Exploration &exploration);
     /*
       A landmark is causal if it is a goal or it is a precondition of an
-      action that must be applied in order to reach the goal.
+      action that must be applied in order to reach the goal. Return for
+      each of the given landmarks whether it is causal.
     */
-    bool is_causal_landmark(const TaskProxy &task_proxy,
-                            Exploration &exploration,
-                            const Landmark &landmark) const;
+    std::vector<bool> are_causal_landmarks(
+        const TaskProxy &task_proxy, Exploration &exploration,
+        const std::vector<const Landmark *> &landmarks) const;
 };
 }
 
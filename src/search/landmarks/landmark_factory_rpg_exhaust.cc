@@ -33,20 +33,41 @@ void LandmarkFactoryRpgExhaust::generate_relaxed_landmarks(
         Landmark landmark({goal.get_pair()}, false, false, true);
         lm_graph->add_landmark(move(landmark));
     }
-    // test all other possible facts
+    /*
+      Test all other possible facts. Facts that are not true in the initial
+      state are landmarks if the relaxed task becomes unsolvable without
+      them. We test all of them together to use batched explorations.
+    */
     State initial_state = task_proxy.get_initial_state();
+    vector<Landmark> candidates;
     for (VariableProxy var : task_proxy.get_variables()) {
         for (int value = 0; value < var.get_domain_size(); ++value) {
             const FactPair lm(var.get_id(), value);
             if (!lm_graph->contains_simple_landmark(lm)) {
-                Landmark landmark({lm}, false, false);
-                if (initial_state[lm.var].get_value() == lm.value ||
-                    !relaxed_task_solvable(task_proxy, exploration, landmark)) {
-                    lm_graph->add_landmark(move(landmark));
-                }
+                candidates.emplace_back(vector<FactPair>{lm}, false, false);
             }
         }
     }
+    vector<const Landmark *> tested;
+    for (const Landmark &landmark : candidates) {
+        const FactPair &lm = landmark.facts[0];
+        if (initial_state[lm.var].get_value() != lm.value) {
+            tested.push_back(&landmark);
+        }
+    }
+    vector<bool> solvable =
+        relaxed_task_solvable(task_proxy, exploration, tested);
+    size_t next_tested = 0;
+    for (Landmark &landmark : candidates) {
+        bool is_landmark = true;
+        if (next_tested < tested.size() && tested[next_tested] == &landmark) {
+            is_landmark = !solvable[next_tested];
+            ++next_tested;
+        }
+        if (is_landmark) {
+            lm_graph->add_landmark(move(landmark));
+        }
+    }
 
     if (only_causal_landmarks) {
         discard_noncausal_landmarks(task_proxy, exploration);
@@ -2,8 +2,11 @@
 
 #include "landmark.h"
 
+#include "../utils/language.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace landmarks {
@@ -14,7 +17,66 @@ namespace landmarks {
 LandmarkStatusManager::LandmarkStatusManager(LandmarkGraph &graph)
     : lm_graph(graph),
       reached_lms(vector<bool>(graph.get_num_landmarks(), true)),
-      lm_status(graph.get_num_landmarks(), lm_not_reached) {
+      lm_status(graph.get_num_landmarks(), lm_not_reached),
+      parent_ids(graph.get_num_landmarks()),
+      greedy_necessary_child_ids(graph.get_num_landmarks()),
+      true_landmarks(graph.get_num_landmarks()) {
+    for (auto &lm_node : graph.get_nodes()) {
+        int id = lm_node->get_id();
+        for (const auto &parent : lm_node->parents) {
+            parent_ids[id].push_back(parent.first->get_id());
+        }
+        for (const auto &child : lm_node->children) {
+            if (child.second >= EdgeType::GREEDY_NECESSARY) {
+                greedy_necessary_child_ids[id].push_back(child.first->get_id());
+            }
+        }
+
+        const Landmark &landmark = lm_node->get_landmark();
+        for (const FactPair &fact : landmark.facts) {
+            if (fact.var >= static_cast<int>(landmarks_by_fact.size())) {
+                landmarks_by_fact.resize(fact.var + 1);
+            }
+            vector<vector<int>> &by_value = landmarks_by_fact[fact.var];
+            if (fact.value >= static_cast<int>(by_value.size())) {
+                by_value.resize(fact.value + 1);
+            }
+            by_value[fact.value].push_back(id);
+            if (landmark.conjunctive) {
+                break;
+            }
+        }
+    }
+}
+
+void LandmarkStatusManager::compute_true_landmarks(const State &state) {
+    for (int id : true_landmark_ids) {
+        true_landmarks.reset(id);
+    }
+    true_landmark_ids.clear();
+
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+    int num_vars = min(values.size(), landmarks_by_fact.size());
+    for (int var = 0; var < num_vars; ++var) {
+        const vector<vector<int>> &by_value = landmarks_by_fact[var];
+        int value = values[var];
+        if (value >= static_cast<int>(by_value.size())) {
+            continue;
+        }
+        for (int id : by_value[value]) {
+            if (true_landmarks.test(id)) {
+                continue;
+            }
+            const Landmark &landmark = lm_graph.get_node(id)->get_landmark();
+            if (landmark.conjunctive && !landmark.is_true_in_state(state)) {
+                continue;
+            }
+            true_landmarks.set(id);
+            true_landmark_ids.push_back(id);
+        }
+    }
+    sort(true_landmark_ids.begin(), true_landmark_ids.end());
 }
 
 BitsetView LandmarkStatusManager::get_reached_landmarks(const State &state) {
@@ -86,6 +148,7 @@ bool LandmarkStatusManager::process_state_transition(
     int num_landmarks = lm_graph.get_num_landmarks();
     assert(reached.size() == num_landmarks);
     assert(parent_reached.size() == num_landmarks);
+    utils::unused_variable(num_landmarks);
 
     /*
        Set all landmarks not reached by this parent as "not reached".
@@ -100,15 +163,16 @@ bool LandmarkStatusManager::process_state_transition(
     reached.intersect(parent_reached);
 
 
-    // Mark landmarks reached right now as "reached" (if they are "leaves").
-    for (int id = 0; id < num_landmarks; ++id) {
-        if (!reached.test(id)) {
-            LandmarkNode *node = lm_graph.get_node(id);
-            if (node->get_landmark().is_true_in_state(ancestor_state)) {
-                if (landmark_is_leaf(*node, reached)) {
-                    reached.set(id);
-                }
-            }
+    /*
+      Mark landmarks reached right now as "reached" (if they are "leaves").
+      Only landmarks that are true in the state can be reached right now.
+      We process them in the order of their IDs since marking a landmark
+      can turn landmarks with higher IDs into leaves.
+    */
+    compute_true_landmarks(ancestor_state);
+    for (int id : true_landmark_ids) {
+        if (!reached.test(id) && landmark_is_leaf(id, reached)) {
+            reached.set(id);
         }
     }
 
@@ -124,21 +188,22 @@ void LandmarkStatusManager::update_lm_status(const State &ancestor_state) {
     for (int id = 0; id < num_landmarks; ++id) {
         lm_status[id] = reached.test(id) ? lm_reached : lm_not_reached;
     }
+    compute_true_landmarks(ancestor_state);
     for (int id = 0; id < num_landmarks; ++id) {
-        if (lm_status[id] == lm_reached
-            && landmark_needed_again(id, ancestor_state)) {
+        if (lm_status[id] == lm_reached && landmark_needed_again(id)) {
             lm_status[id] = lm_needed_again;
         }
     }
 }
 
-bool LandmarkStatusManager::landmark_needed_again(
-    int id, const State &state) {
-    LandmarkNode *node = lm_graph.get_node(id);
-    const Landmark &landmark = node->get_landmark();
-    if (landmark.is_true_in_state(state)) {
+/*
+  Assumes that true_landmarks has been computed for the state in question
+  and that lm_status holds the reached status of all landmarks.
+*/
+bool LandmarkStatusManager::landmark_needed_again(int id) const {
+    if (true_landmarks.test(id)) {
         return false;
-    } else if (landmark.is_true_in_goal) {
+    } else if (lm_graph.get_node(id)->get_landmark().is_true_in_goal) {
         return true;
     } else {
         /*
@@ -146,9 +211,8 @@ bool LandmarkStatusManager::landmark_needed_again(
           true, since A is a necessary precondition for actions
           achieving B for the first time, it must become true again.
         */
-        for (const auto &child : node->children) {
-            if (child.second >= EdgeType::GREEDY_NECESSARY
-                && lm_status[child.first->get_id()] == lm_not_reached) {
+        for (int child_id : greedy_necessary_child_ids[id]) {
+            if (lm_status[child_id] == lm_not_reached) {
                 return true;
             }
         }
@@ -156,13 +220,12 @@ bool LandmarkStatusManager::landmark_needed_again(
     }
 }
 
-bool LandmarkStatusManager::landmark_is_leaf(const LandmarkNode &node,
-                                             const BitsetView &reached) const {
+bool LandmarkStatusManager::landmark_is_leaf(
+    int id, const BitsetView &reached) const {
     //Note: this is the same as !check_node_orders_disobeyed
-    for (const auto &parent : node.parents) {
-        LandmarkNode *parent_node = parent.first;
+    for (int parent_id : parent_ids[id]) {
         // Note: no condition on edge type here
-        if (!reached.test(parent_node->get_id())) {
+        if (!reached.test(parent_id)) {
             return false;
         }
     }
@@ -5,6 +5,10 @@
 
 #include "../per_state_bitset.h"
 
+#include "../algorithms/dynamic_bitset.h"
+
+#include <cstdint>
+
 namespace landmarks {
 class LandmarkGraph;
 class LandmarkNode;
@@ -17,8 +21,29 @@ class LandmarkStatusManager {
     PerStateBitset reached_lms;
     std::vector<landmark_status> lm_status;
 
-    bool landmark_is_leaf(const LandmarkNode &node, const BitsetView &reached) const;
-    bool landmark_needed_again(int id, const State &state);
+    /*
+      Flat copies of the landmark graph for fast status updates: the IDs of
+      the parents of each landmark and the IDs of its children that are
+      ordered at least greedy-necessarily after it.
+    */
+    std::vector<std::vector<int>> parent_ids;
+    std::vector<std::vector<int>> greedy_necessary_child_ids;
+    /*
+      For each fact, the IDs of the simple and disjunctive landmarks
+      containing it and of the conjunctive landmarks whose first fact it is.
+    */
+    std::vector<std::vector<std::vector<int>>> landmarks_by_fact;
+
+    /*
+      Landmarks that are true in the state passed to the last call of
+      compute_true_landmarks(), as a bitset and as a sorted list of IDs.
+    */
+    dynamic_bitset::DynamicBitset<std::uint64_t> true_landmarks;
+    std::vector<int> true_landmark_ids;
+
+    void compute_true_landmarks(const State &state);
+    bool landmark_is_leaf(int id, const BitsetView &reached) const;
+    bool landmark_needed_again(int id) const;
 
     void set_reached_landmarks_for_initial_state(
         const State &initial_state, utils::LogProxy &log);
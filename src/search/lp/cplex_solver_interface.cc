@@ -453,6 +453,37 @@ void CplexSolverInterface::set_mip_gap(double gap) {
     CPX_CALL(CPXsetdblparam, env, CPXPARAM_MIP_Tolerances_MIPGap, gap);
 }
 
+bool CplexSolverInterface::get_basis(LPBasis &basis) const {
+    if (is_mip || is_trivially_unsolvable()) {
+        return false;
+    }
+    int solution_type;
+    CPX_CALL(CPXsolninfo, env, problem, nullptr, &solution_type, nullptr, nullptr);
+    if (solution_type != CPX_BASIC_SOLN) {
+        return false;
+    }
+    basis.variable_status.resize(get_num_variables());
+    row_status.resize(get_num_constraints());
+    CPX_CALL(CPXgetbase, env, problem,
+             basis.variable_status.data(), row_status.data());
+    basis.constraint_status.assign(
+        row_status.begin(), row_status.begin() + num_permanent_constraints);
+    return true;
+}
+
+void CplexSolverInterface::set_basis(const LPBasis &basis) {
+    assert(static_cast<int>(basis.variable_status.size()) == get_num_variables());
+    assert(static_cast<int>(basis.constraint_status.size()) == num_permanent_constraints);
+    if (is_mip) {
+        return;
+    }
+    row_status.assign(
+        basis.constraint_status.begin(), basis.constraint_status.end());
+    row_status.resize(get_num_constraints(), CPX_BASIC);
+    CPX_CALL(CPXcopybase, env, problem,
+             basis.variable_status.data(), row_status.data());
+}
+
 void CplexSolverInterface::solve() {
     if (is_trivially_unsolvable()) {
         return;
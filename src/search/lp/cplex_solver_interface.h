@@ -194,6 +194,9 @@ public:
     std::vector<double> constraint_lower_bounds;
     std::vector<double> constraint_upper_bounds;
 
+    // Keep a buffer for row statuses to avoid reallocation.
+    mutable std::vector<int> row_status;
+
     bool is_trivially_unsolvable() const;
     void change_constraint_bounds(int index, double lb, double ub);
 public:
@@ -211,6 +214,8 @@ public:
     virtual void set_variable_lower_bound(int index, double bound) override;
     virtual void set_variable_upper_bound(int index, double bound) override;
     virtual void set_mip_gap(double gap) override;
+    virtual bool get_basis(LPBasis &basis) const override;
+    virtual void set_basis(const LPBasis &basis) override;
     virtual void solve() override;
     virtual void write_lp(const std::string &filename) const override;
     virtual void print_failure_analysis() const override;
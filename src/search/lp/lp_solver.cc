@@ -183,6 +183,14 @@ void LPSolver::set_mip_gap(double gap) {
     pimpl->set_mip_gap(gap);
 }
 
+bool LPSolver::get_basis(LPBasis &basis) const {
+    return pimpl->get_basis(basis);
+}
+
+void LPSolver::set_basis(const LPBasis &basis) {
+    pimpl->set_basis(basis);
+}
+
 void LPSolver::solve() {
     pimpl->solve();
 }
@@ -95,6 +95,20 @@ public:
     const std::string &get_objective_name() const;
 };
 
+/*
+  Basis of a solved LP: the status of each variable and each permanent
+  constraint. The status values are specific to the solver that produced
+  the basis. We do not store the status of temporary constraints because
+  they usually change between solves. When a basis is restored, all
+  temporary constraints are treated as basic, i.e., their slack variables
+  are in the basis. This always extends a basis of the permanent part to a
+  valid basis of the full LP.
+*/
+struct LPBasis {
+    std::vector<int> variable_status;
+    std::vector<int> constraint_status;
+};
+
 class LPSolver {
     std::unique_ptr<SolverInterface> pimpl;
 public:
@@ -114,6 +128,19 @@ public:
 
     void set_mip_gap(double gap);
 
+    /*
+      Store the basis of the last solve in the given object and return true.
+      Return false and leave the object unchanged if the solver has no basis
+      (e.g., because the last solve detected infeasibility without solving).
+    */
+    bool get_basis(LPBasis &basis) const;
+    /*
+      Use the given basis as the starting basis for the next solve. The basis
+      must stem from a previous call to get_basis() on this solver with the
+      same permanent constraints and variables loaded.
+    */
+    void set_basis(const LPBasis &basis);
+
     void solve();
     void write_lp(const std::string &filename) const;
     void print_failure_analysis() const;
@@ -12,6 +12,7 @@ class NamedVector;
 namespace lp {
 class LinearProgram;
 class LPConstraint;
+struct LPBasis;
 
 class SolverInterface {
 public:
@@ -31,6 +32,9 @@ public:
 
     virtual void set_mip_gap(double gap) = 0;
 
+    virtual bool get_basis(LPBasis &basis) const = 0;
+    virtual void set_basis(const LPBasis &basis) = 0;
+
     virtual void solve() = 0;
     virtual void write_lp(const std::string &filename) const = 0;
     virtual void print_failure_analysis() const = 0;
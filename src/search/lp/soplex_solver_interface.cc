@@ -123,6 +123,34 @@ void SoPlexSolverInterface::set_mip_gap(double /*gap*/) {
      */
 }
 
+bool SoPlexSolverInterface::get_basis(LPBasis &basis) const {
+    if (!soplex.hasBasis()) {
+        return false;
+    }
+    row_status.resize(get_num_constraints());
+    column_status.resize(get_num_variables());
+    soplex.getBasis(row_status.data(), column_status.data());
+    basis.variable_status.assign(column_status.begin(), column_status.end());
+    basis.constraint_status.assign(
+        row_status.begin(), row_status.begin() + num_permanent_constraints);
+    return true;
+}
+
+void SoPlexSolverInterface::set_basis(const LPBasis &basis) {
+    assert(static_cast<int>(basis.variable_status.size()) == get_num_variables());
+    assert(static_cast<int>(basis.constraint_status.size()) == num_permanent_constraints);
+    column_status.clear();
+    for (int status : basis.variable_status) {
+        column_status.push_back(static_cast<SPxSolverBase<double>::VarStatus>(status));
+    }
+    row_status.clear();
+    for (int status : basis.constraint_status) {
+        row_status.push_back(static_cast<SPxSolverBase<double>::VarStatus>(status));
+    }
+    row_status.resize(get_num_constraints(), SPxSolverBase<double>::BASIC);
+    soplex.setBasis(row_status.data(), column_status.data());
+}
+
 void SoPlexSolverInterface::solve() {
     soplex.optimize();
 }
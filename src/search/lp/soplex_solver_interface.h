@@ -28,6 +28,9 @@ class SoPlexSolverInterface : public SolverInterface {
     mutable soplex::SoPlex soplex;
     int num_permanent_constraints;
     int num_temporary_constraints;
+    // Keep buffers for reading and writing bases to avoid reallocation.
+    mutable std::vector<soplex::SPxSolverBase<double>::VarStatus> row_status;
+    mutable std::vector<soplex::SPxSolverBase<double>::VarStatus> column_status;
 public:
     SoPlexSolverInterface();
 
@@ -45,6 +48,8 @@ public:
 
     virtual void set_mip_gap(double gap) override;
 
+    virtual bool get_basis(LPBasis &basis) const override;
+    virtual void set_basis(const LPBasis &basis) override;
     virtual void solve() override;
     virtual void write_lp(const std::string &filename) const override;
     virtual void print_failure_analysis() const override;
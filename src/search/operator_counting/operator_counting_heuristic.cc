@@ -2,6 +2,7 @@
 
 #include "constraint_generator.h"
 
+#include "../evaluation_context.h"
 #include "../plugins/plugin.h"
 #include "../utils/markup.h"
 
@@ -15,7 +16,9 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(const plugins::Options &opt
       constraint_generators(
           opts.get_list<shared_ptr<ConstraintGenerator>>("constraint_generators")),
       lp_solver(opts.get<lp::LPSolverType>("lpsolver")),
-      use_integer_operator_counts(opts.get<bool>("use_integer_operator_counts")) {
+      use_integer_operator_counts(opts.get<bool>("use_integer_operator_counts")),
+      basis_cache_size(use_integer_operator_counts ? 0 : opts.get<int>("basis_cache_size")),
+      parent_state_id(StateID::no_state) {
     lp_solver.set_mip_gap(0);
     named_vector::NamedVector<lp::LPVariable> variables;
     double infinity = lp_solver.get_infinity();
@@ -33,6 +36,43 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(const plugins::Options &opt
 OperatorCountingHeuristic::~OperatorCountingHeuristic() {
 }
 
+EvaluationResult OperatorCountingHeuristic::compute_result(
+    EvaluationContext &eval_context) {
+    parent_state_id = eval_context.get_parent_state_id();
+    return Heuristic::compute_result(eval_context);
+}
+
+const lp::LPBasis *OperatorCountingHeuristic::lookup_basis(StateID state_id) {
+    auto it = cached_basis_positions.find(state_id);
+    if (it == cached_basis_positions.end()) {
+        return nullptr;
+    }
+    // Move the entry to the front to mark it as most recently used.
+    cached_bases.splice(cached_bases.begin(), cached_bases, it->second);
+    return &it->second->second;
+}
+
+void OperatorCountingHeuristic::store_basis(StateID state_id) {
+    assert(basis_cache_size > 0);
+    auto it = cached_basis_positions.find(state_id);
+    if (it != cached_basis_positions.end()) {
+        cached_bases.splice(cached_bases.begin(), cached_bases, it->second);
+    } else if (static_cast<int>(cached_bases.size()) < basis_cache_size) {
+        cached_bases.emplace_front(state_id, lp::LPBasis());
+    } else {
+        // Reuse the least recently used entry to avoid reallocation.
+        cached_basis_positions.erase(cached_bases.back().first);
+        cached_bases.splice(cached_bases.begin(), cached_bases, prev(cached_bases.end()));
+        cached_bases.front().first = state_id;
+    }
+    if (lp_solver.get_basis(cached_bases.front().second)) {
+        cached_basis_positions[state_id] = cached_bases.begin();
+    } else {
+        cached_basis_positions.erase(state_id);
+        cached_bases.pop_front();
+    }
+}
+
 int OperatorCountingHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     assert(!lp_solver.has_temporary_constraints());
@@ -43,12 +83,22 @@ int OperatorCountingHeuristic::compute_heuristic(const State &ancestor_state) {
             return DEAD_END;
         }
     }
+    StateID state_id = ancestor_state.get_id();
+    if (basis_cache_size > 0 && parent_state_id != StateID::no_state) {
+        const lp::LPBasis *parent_basis = lookup_basis(parent_state_id);
+        if (parent_basis) {
+            lp_solver.set_basis(*parent_basis);
+        }
+    }
     int result;
     lp_solver.solve();
     if (lp_solver.has_optimal_solution()) {
         double epsilon = 0.01;
         double objective_value = lp_solver.get_objective_value();
         result = static_cast<int>(ceil(objective_value - epsilon));
+        if (basis_cache_size > 0 && state_id != StateID::no_state) {
+            store_basis(state_id);
+        }
     } else {
         result = DEAD_END;
     }
@@ -90,6 +140,15 @@ public:
             "computationally expensive. Turning this option on can thus drastically "
             "increase the runtime.",
             "false");
+        add_option<int>(
+            "basis_cache_size",
+            "number of LP bases of recently evaluated states to keep for "
+            "warm-starting the LPs of their successors. Use 0 to disable warm "
+            "starts from parent bases. Only eager and lazy search tell the "
+            "heuristic the parent of a state. Warm starts are not used if "
+            "use_integer_operator_counts is enabled.",
+            "100",
+            plugins::Bounds("0", "infinity"));
         lp::add_lp_solver_option_to_feature(*this);
         Heuristic::add_options_to_feature(*this);
 
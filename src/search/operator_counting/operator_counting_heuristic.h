@@ -2,9 +2,12 @@
 #define OPERATOR_COUNTING_OPERATOR_COUNTING_HEURISTIC_H
 
 #include "../heuristic.h"
+#include "../state_id.h"
 
 #include "../lp/lp_solver.h"
 
+#include <list>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -19,11 +22,32 @@ class OperatorCountingHeuristic : public Heuristic {
     std::vector<std::shared_ptr<ConstraintGenerator>> constraint_generators;
     lp::LPSolver lp_solver;
     const bool use_integer_operator_counts;
+
+    /*
+      Small LRU cache of LP bases for recently evaluated states (most
+      recently used first). When evaluating a state, we warm-start the LP
+      from the basis of the parent state if the search passes the parent in
+      the evaluation context and its basis is still cached. Siblings then
+      all start from the same nearby basis instead of the basis of
+      whichever state happened to be solved last.
+    */
+    const int basis_cache_size;
+    using CachedBases = std::list<std::pair<StateID, lp::LPBasis>>;
+    CachedBases cached_bases;
+    std::map<StateID, CachedBases::iterator> cached_basis_positions;
+    // Parent of the state that is currently evaluated.
+    StateID parent_state_id;
+
+    const lp::LPBasis *lookup_basis(StateID state_id);
+    void store_basis(StateID state_id);
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     explicit OperatorCountingHeuristic(const plugins::Options &opts);
     ~OperatorCountingHeuristic();
+
+    virtual EvaluationResult compute_result(
+        EvaluationContext &eval_context) override;
 };
 }
 
@@ -656,6 +656,8 @@ public:
             "transform", options.get<shared_ptr<AbstractTask>>("transform"));
         heuristic_opts.set<bool>(
             "cache_estimates", options.get<bool>("cache_estimates"));
+        heuristic_opts.set<int>(
+            "bounded_cache_memory", options.get<int>("bounded_cache_memory"));
         heuristic_opts.set<shared_ptr<PatternCollectionGenerator>>(
             "patterns", pgh);
         heuristic_opts.set<double>(
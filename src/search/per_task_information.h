@@ -8,6 +8,8 @@
 #include "utils/memory.h"
 
 #include <functional>
+#include <mutex>
+#include <shared_mutex>
 
 /*
   A PerTaskInformation<T> acts like a HashMap<TaskID, T>
@@ -18,6 +20,10 @@
   (2) If a task is destroyed, its associated data in all PerTaskInformation
       objects is automatically destroyed as well.
 
+  PerTaskInformation objects may be accessed from several threads, e.g.,
+  when a parallel portfolio runs searches that create subtasks. Lookups of
+  existing entries share a lock, while adding and removing entries needs
+  exclusive access.
 */
 template<class Entry>
 class PerTaskInformation : public subscriber::Subscriber<AbstractTask> {
@@ -32,6 +38,7 @@ class PerTaskInformation : public subscriber::Subscriber<AbstractTask> {
     using EntryConstructor = std::function<std::unique_ptr<Entry>(const TaskProxy &)>;
     EntryConstructor entry_constructor;
     utils::HashMap<TaskID, std::unique_ptr<Entry>> entries;
+    std::shared_mutex entries_mutex;
 public:
     /*
       If no entry_constructor is passed to the PerTaskInformation explicitly,
@@ -51,16 +58,35 @@ public:
 
     Entry &operator[](const TaskProxy &task_proxy) {
         TaskID id = task_proxy.get_id();
-        const auto &it = entries.find(id);
-        if (it == entries.end()) {
-            entries[id] = entry_constructor(task_proxy);
-            task_proxy.subscribe_to_task_destruction(this);
+        {
+            std::shared_lock<std::shared_mutex> lock(entries_mutex);
+            const auto &it = entries.find(id);
+            if (it != entries.end())
+                return *it->second;
+        }
+
+        /*
+          We create the entry without holding the lock because creating it
+          may access this object for other tasks. If another thread adds an
+          entry for the task in the meantime, we use that one instead.
+        */
+        std::unique_ptr<Entry> entry = entry_constructor(task_proxy);
+        Entry *result;
+        bool inserted;
+        {
+            std::unique_lock<std::shared_mutex> lock(entries_mutex);
+            auto [it, is_new] = entries.try_emplace(id, std::move(entry));
+            result = it->second.get();
+            inserted = is_new;
         }
-        return *entries[id];
+        if (inserted)
+            task_proxy.subscribe_to_task_destruction(this);
+        return *result;
     }
 
     virtual void notify_service_destroyed(const AbstractTask *task) override {
         TaskID id = TaskProxy(*task).get_id();
+        std::unique_lock<std::shared_mutex> lock(entries_mutex);
         entries.erase(id);
     }
 };
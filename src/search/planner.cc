@@ -7,6 +7,7 @@
 #include "utils/system.h"
 #include "utils/timer.h"
 
+#include <fstream>
 #include <iostream>
 
 using namespace std;
@@ -20,10 +21,34 @@ int main(int argc, const char **argv) {
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
     }
 
+    if (static_cast<string>(argv[1]) == "--dump-binary") {
+        if (argc != 3) {
+            utils::g_log << usage(argv[0]) << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        utils::g_log << "reading input..." << endl;
+        tasks::read_root_task_from_stdin();
+        utils::g_log << "done reading input!" << endl;
+        ofstream outfile(argv[2], ios::binary);
+        if (outfile.rdstate() & ofstream::failbit) {
+            cerr << "Failed to open binary task file: " << argv[2] << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        tasks::write_binary_root_task(outfile);
+        outfile.close();
+        if (outfile.fail()) {
+            cerr << "Failed to write binary task file: " << argv[2] << endl;
+            utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+        utils::g_log << "Wrote binary task to " << argv[2] << endl;
+        utils::g_log << "Total time: " << utils::g_timer << endl;
+        return static_cast<int>(ExitCode::SUCCESS);
+    }
+
     bool unit_cost = false;
     if (static_cast<string>(argv[1]) != "--help") {
         utils::g_log << "reading input..." << endl;
-        tasks::read_root_task(cin);
+        tasks::read_root_task_from_stdin();
         utils::g_log << "done reading input!" << endl;
         TaskProxy task_proxy(*tasks::g_root_task);
         unit_cost = task_properties::is_unit_cost(task_proxy);
@@ -5,7 +5,10 @@
 #include "util.h"
 
 #include "../plugins/plugin.h"
+#include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../utils/timer.h"
@@ -17,31 +20,62 @@ using namespace std;
 namespace potentials {
 DiversePotentialHeuristics::DiversePotentialHeuristics(const plugins::Options &opts)
     : optimizer(opts),
+      num_threads(opts.get<int>("num_threads")),
       max_num_heuristics(opts.get<int>("max_num_heuristics")),
       num_samples(opts.get<int>("num_samples")),
       rng(utils::parse_rng_from_options(opts)),
       log(utils::get_log_from_options(opts)) {
+    for (int i = 1; i < num_threads; ++i) {
+        thread_optimizers.push_back(utils::make_unique_ptr<PotentialOptimizer>(opts));
+    }
+}
+
+PotentialOptimizer &DiversePotentialHeuristics::get_optimizer(int thread_id) {
+    if (thread_id == 0) {
+        return optimizer;
+    }
+    assert(utils::in_bounds(thread_id - 1, thread_optimizers));
+    return *thread_optimizers[thread_id - 1];
 }
 
 SamplesToFunctionsMap
 DiversePotentialHeuristics::filter_samples_and_compute_functions(
     const vector<State> &samples) {
     utils::Timer filtering_timer;
-    utils::HashSet<State> dead_ends;
-    int num_duplicates = 0;
-    int num_dead_ends = 0;
-    SamplesToFunctionsMap samples_to_functions;
+    // Skipping duplicates is not necessary, but saves LP evaluations.
+    utils::HashSet<State> unique_samples_set;
+    vector<State> unique_samples;
     for (const State &sample : samples) {
-        // Skipping duplicates is not necessary, but saves LP evaluations.
-        if (samples_to_functions.count(sample) || dead_ends.count(sample)) {
-            ++num_duplicates;
-            continue;
+        if (unique_samples_set.insert(sample).second) {
+            unique_samples.push_back(sample);
         }
-        optimizer.optimize_for_state(sample);
-        if (optimizer.has_optimal_solution()) {
-            samples_to_functions[sample] = optimizer.get_potential_function();
+    }
+    int num_unique_samples = unique_samples.size();
+    int num_duplicates = samples.size() - num_unique_samples;
+
+    /*
+      Each thread solves the LPs for a fixed range of samples, so the
+      functions do not depend on the scheduling of the threads.
+    */
+    vector<unique_ptr<PotentialFunction>> functions(num_unique_samples);
+    utils::run_in_parallel(num_threads, [&](int thread_id) {
+            PotentialOptimizer &thread_optimizer = get_optimizer(thread_id);
+            int begin = static_cast<long long>(num_unique_samples) * thread_id / num_threads;
+            int end = static_cast<long long>(num_unique_samples) * (thread_id + 1) / num_threads;
+            for (int i = begin; i < end; ++i) {
+                thread_optimizer.optimize_for_state(unique_samples[i]);
+                if (thread_optimizer.has_optimal_solution()) {
+                    functions[i] = thread_optimizer.get_potential_function();
+                }
+            }
+        });
+
+    int num_dead_ends = 0;
+    SamplesToFunctionsMap samples_to_functions;
+    for (int i = 0; i < num_unique_samples; ++i) {
+        if (functions[i]) {
+            samples_to_functions[unique_samples[i]] = move(functions[i]);
         } else {
-            dead_ends.insert(sample);
             ++num_dead_ends;
         }
     }
@@ -127,7 +161,7 @@ DiversePotentialHeuristics::find_functions() {
 
     // Sample states.
     vector<State> samples = sample_without_dead_end_detection(
-        optimizer, num_samples, *rng);
+        optimizer, num_samples, *rng, num_threads);
 
     // Filter dead end samples.
     SamplesToFunctionsMap samples_to_functions =
@@ -162,6 +196,8 @@ public:
             "maximum number of potential heuristics",
             "infinity",
             plugins::Bounds("0", "infinity"));
+        add_incremental_evaluation_option_to_feature(*this);
+        add_num_threads_option_to_feature(*this);
         prepare_parser_for_admissible_potentials(*this);
         utils::add_rng_options(*this);
         utils::add_log_options_to_feature(*this);
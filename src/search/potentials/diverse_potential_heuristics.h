@@ -26,6 +26,9 @@ using SamplesToFunctionsMap =
 */
 class DiversePotentialHeuristics {
     PotentialOptimizer optimizer;
+    const int num_threads;
+    // Optimizers for threads 1, ..., num_threads - 1. Thread 0 uses optimizer.
+    std::vector<std::unique_ptr<PotentialOptimizer>> thread_optimizers;
     // TODO: Remove max_num_heuristics and control number of heuristics
     // with num_samples parameter?
     const int max_num_heuristics;
@@ -34,8 +37,11 @@ class DiversePotentialHeuristics {
     utils::LogProxy log;
     std::vector<std::unique_ptr<PotentialFunction>> diverse_functions;
 
+    PotentialOptimizer &get_optimizer(int thread_id);
+
     /* Filter dead end samples and duplicates. Store potential heuristics
-       for remaining samples. */
+       for remaining samples. The LPs for the samples are solved in
+       parallel. */
     SamplesToFunctionsMap filter_samples_and_compute_functions(
         const std::vector<State> &samples);
 
@@ -0,0 +1,93 @@
+#include "potential_ensemble.h"
+
+#include "potential_function.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace potentials {
+/*
+  Use at most 20 fractional bits, but fewer if the sums could otherwise
+  overflow. This bound is safe for the default bound on potentials
+  (max_potential=1e8) even for tasks with many variables.
+*/
+static const int MAX_SCALE_BITS = 20;
+
+static int compute_scale_bits(
+    const vector<unique_ptr<PotentialFunction>> &functions) {
+    double max_abs_sum = 0.0;
+    for (const unique_ptr<PotentialFunction> &function : functions) {
+        double abs_sum = 0.0;
+        for (const vector<double> &var_potentials : function->get_fact_potentials()) {
+            double max_abs_potential = 0.0;
+            for (double potential : var_potentials) {
+                max_abs_potential = max(max_abs_potential, abs(potential));
+            }
+            abs_sum += max_abs_potential;
+        }
+        max_abs_sum = max(max_abs_sum, abs_sum);
+    }
+    // Leave a factor of 4 for the differences used by incremental updates.
+    const double limit = static_cast<double>(numeric_limits<int64_t>::max()) / 4;
+    int scale_bits = MAX_SCALE_BITS;
+    while (scale_bits > 0 && ldexp(max_abs_sum + 1.0, scale_bits) > limit) {
+        --scale_bits;
+    }
+    return scale_bits;
+}
+
+PotentialEnsemble::PotentialEnsemble(
+    const vector<unique_ptr<PotentialFunction>> &functions)
+    : num_functions(functions.size()),
+      scale_bits(compute_scale_bits(functions)) {
+    if (functions.empty())
+        return;
+    const vector<vector<double>> &first_potentials =
+        functions[0]->get_fact_potentials();
+    int num_facts = 0;
+    for (const vector<double> &var_potentials : first_potentials) {
+        fact_offsets.push_back(num_facts);
+        num_facts += var_potentials.size();
+    }
+    weights.resize(static_cast<size_t>(num_facts) * num_functions);
+    for (int i = 0; i < num_functions; ++i) {
+        const vector<vector<double>> &fact_potentials =
+            functions[i]->get_fact_potentials();
+        assert(fact_potentials.size() == first_potentials.size());
+        for (size_t var = 0; var < fact_potentials.size(); ++var) {
+            for (size_t value = 0; value < fact_potentials[var].size(); ++value) {
+                size_t fact = fact_offsets[var] + value;
+                // Round down to never overestimate the exact sum.
+                weights[fact * num_functions + i] = static_cast<int64_t>(
+                    floor(ldexp(fact_potentials[var][value], scale_bits)));
+            }
+        }
+    }
+}
+
+int PotentialEnsemble::convert_sum_to_value(int64_t sum) const {
+    /*
+      Compute ceil(sum / 2^scale_bits - epsilon) with the same epsilon
+      as PotentialFunction::get_value(). We round the scaled epsilon up,
+      so the result never exceeds the value computed with doubles.
+    */
+    const int64_t scale = int64_t(1) << scale_bits;
+    const int64_t epsilon = (scale + 99) / 100;
+    int64_t shifted_sum = sum - epsilon;
+    int64_t value = shifted_sum / scale;
+    if (shifted_sum % scale > 0)
+        ++value;
+    return static_cast<int>(value);
+}
+
+int PotentialEnsemble::get_value(const int64_t *sums) const {
+    int value = 0;
+    for (int i = 0; i < num_functions; ++i) {
+        value = max(value, convert_sum_to_value(sums[i]));
+    }
+    return value;
+}
+}
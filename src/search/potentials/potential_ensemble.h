@@ -0,0 +1,81 @@
+#ifndef POTENTIALS_POTENTIAL_ENSEMBLE_H
+#define POTENTIALS_POTENTIAL_ENSEMBLE_H
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace potentials {
+class PotentialFunction;
+
+/*
+  Compiled representation of one or more potential functions for fast
+  evaluation of their maximum.
+
+  The potentials are stored as fixed-point integers (scaled by
+  2^scale_bits) in a single flat array. The weights of all functions for
+  the same fact are adjacent, so evaluating all functions in a state reads
+  one contiguous block per variable and accumulates it into one sum per
+  function. Potentials are rounded down when they are quantized, so each
+  quantized sum is a lower bound on the exact sum and the resulting
+  heuristic values never exceed the values of the original functions.
+
+  Since the sums are linear in the facts, the sums for a successor state
+  can be derived from the sums of its parent by adding the differences of
+  the potentials of the changed facts (see apply_change()).
+*/
+class PotentialEnsemble {
+    int num_functions;
+    int scale_bits;
+    std::vector<int> fact_offsets;
+    std::vector<std::int64_t> weights;
+
+    const std::int64_t *get_weights(int var, int value) const {
+        assert(var >= 0 && var < static_cast<int>(fact_offsets.size()));
+        return &weights[static_cast<std::size_t>(fact_offsets[var] + value) *
+                        num_functions];
+    }
+
+    int convert_sum_to_value(std::int64_t sum) const;
+
+public:
+    explicit PotentialEnsemble(
+        const std::vector<std::unique_ptr<PotentialFunction>> &functions);
+
+    int get_num_functions() const {
+        return num_functions;
+    }
+
+    // Store the sum of each function for the given state in sums.
+    void compute_sums(
+        const std::vector<int> &state_values, std::int64_t *sums) const {
+        for (int i = 0; i < num_functions; ++i) {
+            sums[i] = 0;
+        }
+        int num_vars = fact_offsets.size();
+        assert(static_cast<int>(state_values.size()) == num_vars);
+        for (int var = 0; var < num_vars; ++var) {
+            const std::int64_t *fact_weights = get_weights(var, state_values[var]);
+            for (int i = 0; i < num_functions; ++i) {
+                sums[i] += fact_weights[i];
+            }
+        }
+    }
+
+    // Update sums for a change of the value of var.
+    void apply_change(
+        std::int64_t *sums, int var, int old_value, int new_value) const {
+        const std::int64_t *old_weights = get_weights(var, old_value);
+        const std::int64_t *new_weights = get_weights(var, new_value);
+        for (int i = 0; i < num_functions; ++i) {
+            sums[i] += new_weights[i] - old_weights[i];
+        }
+    }
+
+    // Return the maximum of 0 and the heuristic values of all functions.
+    int get_value(const std::int64_t *sums) const;
+};
+}
+
+#endif
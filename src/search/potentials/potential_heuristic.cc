@@ -7,10 +7,18 @@
 using namespace std;
 
 namespace potentials {
+static vector<unique_ptr<PotentialFunction>> make_singleton(
+    unique_ptr<PotentialFunction> function) {
+    vector<unique_ptr<PotentialFunction>> functions;
+    functions.push_back(move(function));
+    return functions;
+}
+
 PotentialHeuristic::PotentialHeuristic(
     const plugins::Options &opts, unique_ptr<PotentialFunction> function)
     : Heuristic(opts),
-      function(move(function)) {
+      ensemble(make_singleton(move(function))),
+      sum(0) {
 }
 
 PotentialHeuristic::~PotentialHeuristic() {
@@ -18,6 +26,8 @@ PotentialHeuristic::~PotentialHeuristic() {
 
 int PotentialHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    return max(0, function->get_value(state));
+    state.unpack();
+    ensemble.compute_sums(state.get_unpacked_values(), &sum);
+    return ensemble.get_value(&sum);
 }
 }
@@ -1,8 +1,11 @@
 #ifndef POTENTIALS_POTENTIAL_HEURISTIC_H
 #define POTENTIALS_POTENTIAL_HEURISTIC_H
 
+#include "potential_ensemble.h"
+
 #include "../heuristic.h"
 
+#include <cstdint>
 #include <memory>
 
 namespace potentials {
@@ -12,7 +15,8 @@ class PotentialFunction;
   Use an internal potential function to evaluate a given state.
 */
 class PotentialHeuristic : public Heuristic {
-    std::unique_ptr<PotentialFunction> function;
+    PotentialEnsemble ensemble;
+    std::int64_t sum;
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
@@ -3,23 +3,99 @@
 #include "potential_function.h"
 
 #include "../plugins/plugin.h"
+#include "../tasks/cost_adapted_task.h"
+#include "../tasks/root_task.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <limits>
 
 using namespace std;
 
 namespace potentials {
+// Marks states whose sums have not been computed yet.
+static const int64_t UNKNOWN_SUM = numeric_limits<int64_t>::min();
+
 PotentialMaxHeuristic::PotentialMaxHeuristic(
     const plugins::Options &opts,
     vector<unique_ptr<PotentialFunction>> &&functions)
     : Heuristic(opts),
-      functions(move(functions)) {
+      ensemble(functions),
+      incremental(opts.get<bool>("incremental", false)),
+      state_sums(vector<int64_t>(max(1, ensemble.get_num_functions()), UNKNOWN_SUM)),
+      sums(ensemble.get_num_functions()) {
+    /*
+      Incremental updates apply the operators of the states' task, so the
+      heuristic's task must have the same variables. As in the landmark
+      heuristics, we approximate this test.
+    */
+    if (incremental && task != tasks::g_root_task &&
+        dynamic_cast<tasks::CostAdaptedTask *>(task.get()) == nullptr) {
+        cerr << "Incremental evaluation of potential heuristics only "
+             << "supports task transformations that modify the operator "
+             << "costs." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
 }
 
 int PotentialMaxHeuristic::compute_heuristic(const State &ancestor_state) {
+    if (ensemble.get_num_functions() == 0) {
+        return 0;
+    }
+    if (incremental && ancestor_state.get_registry()) {
+        ArrayView<int64_t> stored_sums = state_sums[ancestor_state];
+        if (stored_sums[0] == UNKNOWN_SUM) {
+            ancestor_state.unpack();
+            ensemble.compute_sums(ancestor_state.get_unpacked_values(), sums.data());
+            for (size_t i = 0; i < sums.size(); ++i) {
+                stored_sums[i] = sums[i];
+            }
+        }
+        return ensemble.get_value(&stored_sums[0]);
+    }
     State state = convert_ancestor_state(ancestor_state);
-    int value = 0;
-    for (auto &function : functions) {
-        value = max(value, function->get_value(state));
+    state.unpack();
+    ensemble.compute_sums(state.get_unpacked_values(), sums.data());
+    return ensemble.get_value(sums.data());
+}
+
+void PotentialMaxHeuristic::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    if (incremental) {
+        evals.insert(this);
     }
-    return value;
+}
+
+void PotentialMaxHeuristic::notify_state_transition(
+    const State &parent_state, OperatorID op_id, const State &state) {
+    if (ensemble.get_num_functions() == 0) {
+        return;
+    }
+    ArrayView<int64_t> parent_sums = state_sums[parent_state];
+    ArrayView<int64_t> child_sums = state_sums[state];
+    if (parent_sums[0] == UNKNOWN_SUM || child_sums[0] != UNKNOWN_SUM) {
+        return;
+    }
+    for (size_t i = 0; i < sums.size(); ++i) {
+        child_sums[i] = parent_sums[i];
+    }
+    // Potential heuristics support neither axioms nor conditional effects.
+    OperatorProxy op = parent_state.get_task().get_operators()[op_id];
+    for (EffectProxy effect : op.get_effects()) {
+        FactPair fact = effect.get_fact().get_pair();
+        int old_value = parent_state[fact.var].get_value();
+        if (old_value != fact.value) {
+            ensemble.apply_change(&child_sums[0], fact.var, old_value, fact.value);
+        }
+    }
+}
+
+void add_incremental_evaluation_option_to_feature(plugins::Feature &feature) {
+    feature.add_option<bool>(
+        "incremental",
+        "compute the values of successor states incrementally from the "
+        "values of their parents. This stores one 64-bit number per "
+        "potential function for each state.",
+        "false");
 }
 }
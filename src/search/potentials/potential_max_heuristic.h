@@ -1,19 +1,35 @@
 #ifndef POTENTIALS_POTENTIAL_MAX_HEURISTIC_H
 #define POTENTIALS_POTENTIAL_MAX_HEURISTIC_H
 
+#include "potential_ensemble.h"
+
 #include "../heuristic.h"
+#include "../per_state_array.h"
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
+namespace plugins {
+class Feature;
+}
+
 namespace potentials {
 class PotentialFunction;
 
 /*
   Maximize over multiple potential functions.
+
+  With incremental evaluation, the sums of all functions are stored for
+  each registered state and the sums of a successor are derived from the
+  sums of its parent by only considering the variables changed by the
+  applied operator.
 */
 class PotentialMaxHeuristic : public Heuristic {
-    std::vector<std::unique_ptr<PotentialFunction>> functions;
+    PotentialEnsemble ensemble;
+    const bool incremental;
+    PerStateArray<std::int64_t> state_sums;
+    std::vector<std::int64_t> sums;
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
@@ -23,7 +39,16 @@ public:
         const plugins::Options &opts,
         std::vector<std::unique_ptr<PotentialFunction>> &&functions);
     ~PotentialMaxHeuristic() = default;
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void notify_state_transition(
+        const State &parent_state, OperatorID op_id,
+        const State &state) override;
 };
+
+extern void add_incremental_evaluation_option_to_feature(
+    plugins::Feature &feature);
 }
 
 #endif
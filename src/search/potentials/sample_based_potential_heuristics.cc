@@ -4,9 +4,13 @@
 #include "util.h"
 
 #include "../plugins/plugin.h"
+#include "../task_utils/sampling.h"
+#include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -27,9 +31,9 @@ static void filter_dead_ends(PotentialOptimizer &optimizer, vector<State> &sampl
 static void optimize_for_samples(
     PotentialOptimizer &optimizer,
     int num_samples,
-    utils::RandomNumberGenerator &rng) {
+    const sampling::RandomWalkSampler &sampler) {
     vector<State> samples = sample_without_dead_end_detection(
-        optimizer, num_samples, rng);
+        optimizer, num_samples, sampler);
     if (!optimizer.potentials_are_bounded()) {
         filter_dead_ends(optimizer, samples);
     }
@@ -39,16 +43,50 @@ static void optimize_for_samples(
 /*
   Compute multiple potential functions that are optimized for different
   sets of samples.
+
+  With multiple threads, each function is computed with its own random
+  number generator, seeded from the global one. Thread i computes the
+  functions i, i + num_threads, ... with its own LP, so the result does
+  not depend on the scheduling of the threads. The random walk samplers
+  look up per-task information, so we create them before starting the
+  threads.
 */
 static vector<unique_ptr<PotentialFunction>> create_sample_based_potential_functions(
     const plugins::Options &opts) {
-    vector<unique_ptr<PotentialFunction>> functions;
-    PotentialOptimizer optimizer(opts);
+    int num_heuristics = opts.get<int>("num_heuristics");
+    int num_samples = opts.get<int>("num_samples");
+    int num_threads = opts.get<int>("num_threads");
     shared_ptr<utils::RandomNumberGenerator> rng(utils::parse_rng_from_options(opts));
-    for (int i = 0; i < opts.get<int>("num_heuristics"); ++i) {
-        optimize_for_samples(optimizer, opts.get<int>("num_samples"), *rng);
-        functions.push_back(optimizer.get_potential_function());
+    vector<unique_ptr<PotentialFunction>> functions;
+    if (num_threads == 1) {
+        PotentialOptimizer optimizer(opts);
+        TaskProxy task_proxy(*optimizer.get_task());
+        sampling::RandomWalkSampler sampler(task_proxy, *rng);
+        for (int i = 0; i < num_heuristics; ++i) {
+            optimize_for_samples(optimizer, num_samples, sampler);
+            functions.push_back(optimizer.get_potential_function());
+        }
+        return functions;
+    }
+
+    shared_ptr<AbstractTask> task = opts.get<shared_ptr<AbstractTask>>("transform");
+    TaskProxy task_proxy(*task);
+    vector<unique_ptr<utils::RandomNumberGenerator>> function_rngs;
+    vector<unique_ptr<sampling::RandomWalkSampler>> samplers;
+    for (int i = 0; i < num_heuristics; ++i) {
+        function_rngs.push_back(utils::make_unique_ptr<utils::RandomNumberGenerator>(
+                                    rng->random(numeric_limits<int>::max())));
+        samplers.push_back(utils::make_unique_ptr<sampling::RandomWalkSampler>(
+                               task_proxy, *function_rngs.back()));
     }
+    functions.resize(num_heuristics);
+    utils::run_in_parallel(num_threads, [&](int thread_id) {
+            PotentialOptimizer optimizer(opts);
+            for (int i = thread_id; i < num_heuristics; i += num_threads) {
+                optimize_for_samples(optimizer, num_samples, *samplers[i]);
+                functions[i] = optimizer.get_potential_function();
+            }
+        });
     return functions;
 }
 
@@ -70,6 +108,8 @@ public:
             "Number of states to sample",
             "1000",
             plugins::Bounds("0", "infinity"));
+        add_incremental_evaluation_option_to_feature(*this);
+        add_num_threads_option_to_feature(*this);
         prepare_parser_for_admissible_potentials(*this);
         utils::add_rng_options(*this);
     }
@@ -8,8 +8,12 @@
 #include "../plugins/plugin.h"
 #include "../task_utils/sampling.h"
 #include "../utils/markup.h"
+#include "../utils/memory.h"
+#include "../utils/parallel.h"
+#include "../utils/rng.h"
 
 #include <limits>
+#include <memory>
 
 using namespace std;
 
@@ -17,13 +21,63 @@ namespace potentials {
 vector<State> sample_without_dead_end_detection(
     PotentialOptimizer &optimizer,
     int num_samples,
-    utils::RandomNumberGenerator &rng) {
+    utils::RandomNumberGenerator &rng,
+    int num_threads) {
+    const shared_ptr<AbstractTask> task = optimizer.get_task();
+    const TaskProxy task_proxy(*task);
+    State initial_state = task_proxy.get_initial_state();
+    optimizer.optimize_for_state(initial_state);
+    int init_h = optimizer.get_potential_function()->get_value(initial_state);
+    if (num_threads == 1) {
+        sampling::RandomWalkSampler sampler(task_proxy, rng);
+        vector<State> samples;
+        samples.reserve(num_samples);
+        for (int i = 0; i < num_samples; ++i) {
+            samples.push_back(sampler.sample_state(init_h));
+        }
+        return samples;
+    }
+
+    /*
+      The samplers look up per-task information, which is not thread-safe,
+      so we construct them before starting the threads.
+    */
+    vector<unique_ptr<utils::RandomNumberGenerator>> thread_rngs;
+    vector<unique_ptr<sampling::RandomWalkSampler>> samplers;
+    for (int i = 0; i < num_threads; ++i) {
+        thread_rngs.push_back(utils::make_unique_ptr<utils::RandomNumberGenerator>(
+                                  rng.random(numeric_limits<int>::max())));
+        samplers.push_back(utils::make_unique_ptr<sampling::RandomWalkSampler>(
+                               task_proxy, *thread_rngs.back()));
+    }
+    vector<vector<State>> samples_by_thread(num_threads);
+    utils::run_in_parallel(num_threads, [&](int thread_id) {
+            const sampling::RandomWalkSampler &sampler = *samplers[thread_id];
+            int begin = static_cast<long long>(num_samples) * thread_id / num_threads;
+            int end = static_cast<long long>(num_samples) * (thread_id + 1) / num_threads;
+            vector<State> &thread_samples = samples_by_thread[thread_id];
+            thread_samples.reserve(end - begin);
+            for (int i = begin; i < end; ++i) {
+                thread_samples.push_back(sampler.sample_state(init_h));
+            }
+        });
+    vector<State> samples;
+    samples.reserve(num_samples);
+    for (vector<State> &thread_samples : samples_by_thread) {
+        move(thread_samples.begin(), thread_samples.end(), back_inserter(samples));
+    }
+    return samples;
+}
+
+vector<State> sample_without_dead_end_detection(
+    PotentialOptimizer &optimizer,
+    int num_samples,
+    const sampling::RandomWalkSampler &sampler) {
     const shared_ptr<AbstractTask> task = optimizer.get_task();
     const TaskProxy task_proxy(*task);
     State initial_state = task_proxy.get_initial_state();
     optimizer.optimize_for_state(initial_state);
     int init_h = optimizer.get_potential_function()->get_value(initial_state);
-    sampling::RandomWalkSampler sampler(task_proxy, rng);
     vector<State> samples;
     samples.reserve(num_samples);
     for (int i = 0; i < num_samples; ++i) {
@@ -65,4 +119,15 @@ void prepare_parser_for_admissible_potentials(plugins::Feature &feature) {
     lp::add_lp_solver_option_to_feature(feature);
     Heuristic::add_options_to_feature(feature);
 }
+
+void add_num_threads_option_to_feature(plugins::Feature &feature) {
+    feature.add_option<int>(
+        "num_threads",
+        "number of threads for sampling states and computing potential "
+        "functions. The results are reproducible for a fixed random seed "
+        "and number of threads, but different numbers of threads can yield "
+        "different heuristics.",
+        "1",
+        plugins::Bounds("1", "infinity"));
+}
 }
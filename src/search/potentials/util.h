@@ -11,6 +11,10 @@ namespace plugins {
 class Feature;
 }
 
+namespace sampling {
+class RandomWalkSampler;
+}
+
 namespace utils {
 class RandomNumberGenerator;
 }
@@ -18,13 +22,32 @@ class RandomNumberGenerator;
 namespace potentials {
 class PotentialOptimizer;
 
+/*
+  Sample states with random walks. With more than one thread, the random
+  walks are split into num_threads streams that run in parallel. Each
+  stream uses its own random number generator seeded from rng, so the
+  samples only depend on the seed of rng and the number of threads.
+*/
+std::vector<State> sample_without_dead_end_detection(
+    PotentialOptimizer &optimizer,
+    int num_samples,
+    utils::RandomNumberGenerator &rng,
+    int num_threads);
+
+/*
+  Sample states with random walks of the given sampler in the calling
+  thread. The sampler must belong to the task of the optimizer. Since
+  creating a sampler accesses per-task information, callers that sample in
+  several threads should create all samplers before starting the threads.
+*/
 std::vector<State> sample_without_dead_end_detection(
     PotentialOptimizer &optimizer,
     int num_samples,
-    utils::RandomNumberGenerator &rng);
+    const sampling::RandomWalkSampler &sampler);
 
 std::string get_admissible_potentials_reference();
 void prepare_parser_for_admissible_potentials(plugins::Feature &feature);
+void add_num_threads_option_to_feature(plugins::Feature &feature);
 }
 
 #endif
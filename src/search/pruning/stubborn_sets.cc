@@ -6,6 +6,20 @@
 using namespace std;
 
 namespace stubborn_sets {
+OperatorsByFact::OperatorsByFact(
+    const vector<vector<vector<int>>> &ops_by_var_and_value) {
+    variable_offsets.reserve(ops_by_var_and_value.size() + 1);
+    list_offsets.push_back(0);
+    for (const vector<vector<int>> &ops_by_value : ops_by_var_and_value) {
+        variable_offsets.push_back(list_offsets.size() - 1);
+        for (const vector<int> &ops : ops_by_value) {
+            operators.insert(operators.end(), ops.begin(), ops.end());
+            list_offsets.push_back(operators.size());
+        }
+    }
+    variable_offsets.push_back(list_offsets.size() - 1);
+}
+
 StubbornSets::StubbornSets(const plugins::Options &opts)
     : PruningMethod(opts),
       num_operators(-1) {
@@ -44,22 +58,24 @@ void StubbornSets::compute_sorted_operators(const TaskProxy &task_proxy) {
 }
 
 void StubbornSets::compute_achievers(const TaskProxy &task_proxy) {
-    achievers = utils::map_vector<vector<vector<int>>>(
-        task_proxy.get_variables(), [](const VariableProxy &var) {
-            return vector<vector<int>>(var.get_domain_size());
-        });
+    vector<vector<vector<int>>> ops_by_fact =
+        utils::map_vector<vector<vector<int>>>(
+            task_proxy.get_variables(), [](const VariableProxy &var) {
+                return vector<vector<int>>(var.get_domain_size());
+            });
 
     for (const OperatorProxy op : task_proxy.get_operators()) {
         for (const EffectProxy effect : op.get_effects()) {
             FactPair fact = effect.get_fact().get_pair();
-            achievers[fact.var][fact.value].push_back(op.get_id());
+            ops_by_fact[fact.var][fact.value].push_back(op.get_id());
         }
     }
+    achievers = OperatorsByFact(ops_by_fact);
 }
 
 void StubbornSets::prune(const State &state, vector<OperatorID> &op_ids) {
     // Clear stubborn set from previous call.
-    stubborn.assign(num_operators, false);
+    stubborn.assign((num_operators + 63) / 64, 0);
 
     compute_stubborn_set(state);
 
@@ -67,7 +83,7 @@ void StubbornSets::prune(const State &state, vector<OperatorID> &op_ids) {
     vector<OperatorID> remaining_op_ids;
     remaining_op_ids.reserve(op_ids.size());
     for (OperatorID op_id : op_ids) {
-        if (stubborn[op_id.get_index()]) {
+        if (is_stubborn(op_id.get_index())) {
             remaining_op_ids.emplace_back(op_id);
         }
     }
@@ -4,10 +4,41 @@
 #include "../pruning_method.h"
 #include "../task_proxy.h"
 
+#include <cstdint>
+#include <span>
+
 namespace stubborn_sets {
 inline FactPair find_unsatisfied_condition(
     const std::vector<FactPair> &conditions, const State &state);
 
+/*
+  Maps each fact to a list of operator indices. All lists are stored in
+  one array (compressed sparse row format), which avoids one allocation
+  per fact and keeps the lists of sibling facts (facts of the same
+  variable) next to each other in memory.
+*/
+class OperatorsByFact {
+    std::vector<int> variable_offsets;
+    // The list of fact i is stored in [list_offsets[i], list_offsets[i + 1]).
+    std::vector<int> list_offsets;
+    std::vector<int> operators;
+public:
+    OperatorsByFact() = default;
+    explicit OperatorsByFact(
+        const std::vector<std::vector<std::vector<int>>> &ops_by_var_and_value);
+
+    int get_num_values(int var) const {
+        return variable_offsets[var + 1] - variable_offsets[var];
+    }
+
+    std::span<const int> operator[](const FactPair &fact) const {
+        int fact_id = variable_offsets[fact.var] + fact.value;
+        return std::span<const int>(
+            operators.data() + list_offsets[fact_id],
+            operators.data() + list_offsets[fact_id + 1]);
+    }
+};
+
 class StubbornSets : public PruningMethod {
     void compute_sorted_operators(const TaskProxy &task_proxy);
     void compute_achievers(const TaskProxy &task_proxy);
@@ -23,13 +54,29 @@ protected:
     std::vector<std::vector<FactPair>> sorted_op_effects;
     std::vector<FactPair> sorted_goals;
 
-    /* achievers[var][value] contains all operator indices of
-       operators that achieve the fact (var, value). */
-    std::vector<std::vector<std::vector<int>>> achievers;
+    /* achievers[fact] contains all operator indices of operators
+       that achieve the fact. */
+    OperatorsByFact achievers;
+
+    /* Bit op_no of stubborn is set iff the operator with operator index
+       op_no is contained in the stubborn set. We use 64-bit words rather
+       than vector<bool> so that resetting and querying the set in every
+       call to prune is as cheap as possible. */
+    std::vector<uint64_t> stubborn;
 
-    /* stubborn[op_no] is true iff the operator with operator index
-       op_no is contained in the stubborn set */
-    std::vector<bool> stubborn;
+    bool is_stubborn(int op_no) const {
+        return (stubborn[op_no / 64] >> (op_no % 64)) & 1;
+    }
+
+    // Return true iff the operator was not yet contained in the stubborn set.
+    bool mark_stubborn(int op_no) {
+        uint64_t &word = stubborn[op_no / 64];
+        uint64_t mask = uint64_t(1) << (op_no % 64);
+        if (word & mask)
+            return false;
+        word |= mask;
+        return true;
+    }
 
     /*
       Return the first unsatified precondition,
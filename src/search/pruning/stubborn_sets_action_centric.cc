@@ -1,32 +1,103 @@
 #include "stubborn_sets_action_centric.h"
 
+#include "../utils/collections.h"
+
+#include <algorithm>
+
 using namespace std;
 
 namespace stubborn_sets {
-// Relies on both fact sets being sorted by variable.
-static bool contain_conflicting_fact(const vector<FactPair> &facts1,
-                                     const vector<FactPair> &facts2) {
-    auto facts1_it = facts1.begin();
-    auto facts2_it = facts2.begin();
-    while (facts1_it != facts1.end() && facts2_it != facts2.end()) {
-        if (facts1_it->var < facts2_it->var) {
-            ++facts1_it;
-        } else if (facts1_it->var > facts2_it->var) {
-            ++facts2_it;
-        } else {
-            if (facts1_it->value != facts2_it->value)
-                return true;
-            ++facts1_it;
-            ++facts2_it;
+static const int BLOCK_SIZE = 1 << 16;
+
+// Return memory for size elements at the end of the last block.
+template<typename T>
+static T *allocate(vector<vector<T>> &blocks, int size) {
+    if (blocks.empty() ||
+        blocks.back().capacity() - blocks.back().size() <
+        static_cast<size_t>(size)) {
+        blocks.emplace_back();
+        blocks.back().reserve(max(size, BLOCK_SIZE));
+    }
+    vector<T> &block = blocks.back();
+    size_t start = block.size();
+    // This never reallocates, so pointers to previous rows stay valid.
+    block.resize(start + size);
+    return block.data() + start;
+}
+
+void LazyOperatorRelation::initialize(int num_operators) {
+    num_words = (num_operators + 63) / 64;
+    sparse_rows.assign(num_operators, nullptr);
+    sparse_row_sizes.assign(num_operators, 0);
+    dense_rows.assign(num_operators, nullptr);
+    sparse_blocks.clear();
+    dense_blocks.clear();
+    scratch_row.assign(num_words, 0);
+}
+
+void LazyOperatorRelation::set_row(int op_no, const vector<int> &ops) {
+    assert(!has_row(op_no));
+    // Collecting the operators in a bitset sorts them and removes duplicates.
+    for (int op : ops) {
+        scratch_row[op / 64] |= uint64_t(1) << (op % 64);
+    }
+    scratch_row[op_no / 64] &= ~(uint64_t(1) << (op_no % 64));
+    int size = 0;
+    for (uint64_t word : scratch_row) {
+        size += popcount(word);
+    }
+
+    if (size * sizeof(int) > num_words * sizeof(uint64_t)) {
+        uint64_t *dense_row = allocate(dense_blocks, num_words);
+        copy(scratch_row.begin(), scratch_row.end(), dense_row);
+        dense_rows[op_no] = dense_row;
+    } else {
+        int *sparse_row = allocate(sparse_blocks, size);
+        sparse_rows[op_no] = sparse_row;
+        sparse_row_sizes[op_no] = size;
+        for (int i = 0; i < num_words; ++i) {
+            for (uint64_t word = scratch_row[i]; word; word &= word - 1) {
+                *sparse_row++ = i * 64 + countr_zero(word);
+            }
+        }
+    }
+    fill(scratch_row.begin(), scratch_row.end(), 0);
+}
+
+/* Append the operators listed for all facts of the same variable as fact,
+   except fact itself. */
+static void add_sibling_operators(const OperatorsByFact &ops_by_fact,
+                                  const FactPair &fact,
+                                  vector<int> &ops) {
+    int num_values = ops_by_fact.get_num_values(fact.var);
+    for (int value = 0; value < num_values; ++value) {
+        if (value != fact.value) {
+            span<const int> sibling_ops = ops_by_fact[FactPair(fact.var, value)];
+            ops.insert(ops.end(), sibling_ops.begin(), sibling_ops.end());
         }
     }
-    return false;
 }
 
 StubbornSetsActionCentric::StubbornSetsActionCentric(const plugins::Options &opts)
     : StubbornSets(opts) {
 }
 
+void StubbornSetsActionCentric::initialize(const shared_ptr<AbstractTask> &task) {
+    StubbornSets::initialize(task);
+    TaskProxy task_proxy(*task);
+    vector<vector<vector<int>>> ops_by_fact =
+        utils::map_vector<vector<vector<int>>>(
+            task_proxy.get_variables(), [](const VariableProxy &var) {
+                return vector<vector<int>>(var.get_domain_size());
+            });
+    for (int op_no = 0; op_no < num_operators; ++op_no) {
+        for (const FactPair &pre : sorted_op_preconditions[op_no]) {
+            ops_by_fact[pre.var][pre.value].push_back(op_no);
+        }
+    }
+    consumers = OperatorsByFact(ops_by_fact);
+}
+
 void StubbornSetsActionCentric::compute_stubborn_set(const State &state) {
     assert(stubborn_queue.empty());
 
@@ -40,21 +111,47 @@ void StubbornSetsActionCentric::compute_stubborn_set(const State &state) {
     }
 }
 
-// Relies on op_preconds and op_effects being sorted by variable.
-bool StubbornSetsActionCentric::can_disable(int op1_no, int op2_no) const {
-    return contain_conflicting_fact(sorted_op_effects[op1_no],
-                                    sorted_op_preconditions[op2_no]);
+void StubbornSetsActionCentric::add_disabled_operators(
+    int op1_no, vector<int> &ops) const {
+    for (const FactPair &effect : sorted_op_effects[op1_no]) {
+        add_sibling_operators(consumers, effect, ops);
+    }
 }
 
-// Relies on op_effect being sorted by variable.
-bool StubbornSetsActionCentric::can_conflict(int op1_no, int op2_no) const {
-    return contain_conflicting_fact(sorted_op_effects[op1_no],
-                                    sorted_op_effects[op2_no]);
+void StubbornSetsActionCentric::add_disabling_operators(
+    int op1_no, vector<int> &ops) const {
+    for (const FactPair &pre : sorted_op_preconditions[op1_no]) {
+        add_sibling_operators(achievers, pre, ops);
+    }
+}
+
+void StubbornSetsActionCentric::add_conflicting_operators(
+    int op1_no, vector<int> &ops) const {
+    for (const FactPair &effect : sorted_op_effects[op1_no]) {
+        add_sibling_operators(achievers, effect, ops);
+    }
+}
+
+void StubbornSetsActionCentric::enqueue_stubborn_operators(
+    const LazyOperatorRelation &relation, int op_no) {
+    if (relation.has_dense_row(op_no)) {
+        span<const uint64_t> row = relation.get_dense_row(op_no);
+        for (size_t i = 0; i < row.size(); ++i) {
+            uint64_t added = row[i] & ~stubborn[i];
+            stubborn[i] |= added;
+            for (; added; added &= added - 1) {
+                stubborn_queue.push_back(i * 64 + countr_zero(added));
+            }
+        }
+    } else {
+        for (int op : relation.get_sparse_row(op_no)) {
+            enqueue_stubborn_operator(op);
+        }
+    }
 }
 
 bool StubbornSetsActionCentric::enqueue_stubborn_operator(int op_no) {
-    if (!stubborn[op_no]) {
-        stubborn[op_no] = true;
+    if (mark_stubborn(op_no)) {
         stubborn_queue.push_back(op_no);
         return true;
     }
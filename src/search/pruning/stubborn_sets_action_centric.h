@@ -3,7 +3,78 @@
 
 #include "stubborn_sets.h"
 
+#include <bit>
+#include <cassert>
+
 namespace stubborn_sets {
+/*
+  Operator relation whose rows are computed on demand. Each row is stored
+  either as a sorted list of operator indices or, if that would take more
+  memory, as a bitset with one bit per operator. Dense rows can then be
+  processed a 64-bit word at a time. Rows are copied into large blocks of
+  memory that are never reallocated, which avoids the overhead of one
+  vector per row.
+*/
+class LazyOperatorRelation {
+    int num_words;
+    std::vector<const int *> sparse_rows;
+    std::vector<int> sparse_row_sizes;
+    std::vector<const uint64_t *> dense_rows;
+    std::vector<std::vector<int>> sparse_blocks;
+    std::vector<std::vector<uint64_t>> dense_blocks;
+    std::vector<uint64_t> scratch_row;
+public:
+    void initialize(int num_operators);
+
+    bool has_row(int op_no) const {
+        return sparse_rows[op_no] || dense_rows[op_no];
+    }
+
+    bool has_dense_row(int op_no) const {
+        return dense_rows[op_no];
+    }
+
+    std::span<const int> get_sparse_row(int op_no) const {
+        assert(sparse_rows[op_no]);
+        return std::span<const int>(sparse_rows[op_no], sparse_row_sizes[op_no]);
+    }
+
+    std::span<const uint64_t> get_dense_row(int op_no) const {
+        assert(dense_rows[op_no]);
+        return std::span<const uint64_t>(dense_rows[op_no], num_words);
+    }
+
+    /*
+      Set the row of op_no to the given operators. The operators may be
+      given in any order and contain duplicates and op_no itself, which is
+      not included in the row.
+    */
+    void set_row(int op_no, const std::vector<int> &ops);
+
+    /*
+      Call callback for all operators in the row of op_no in increasing
+      order, restricted to the operators whose bit is set in mask.
+    */
+    template<typename Callback>
+    void for_each_operator(int op_no, const std::vector<uint64_t> &mask,
+                           const Callback &callback) const {
+        if (has_dense_row(op_no)) {
+            const uint64_t *row = dense_rows[op_no];
+            for (int i = 0; i < num_words; ++i) {
+                for (uint64_t word = row[i] & mask[i]; word; word &= word - 1) {
+                    callback(i * 64 + std::countr_zero(word));
+                }
+            }
+        } else {
+            for (int op : get_sparse_row(op_no)) {
+                if ((mask[op / 64] >> (op % 64)) & 1) {
+                    callback(op);
+                }
+            }
+        }
+    }
+};
+
 class StubbornSetsActionCentric : public stubborn_sets::StubbornSets {
     /*
       stubborn_queue contains the operator indices of operators that
@@ -17,9 +88,23 @@ class StubbornSetsActionCentric : public stubborn_sets::StubbornSets {
     virtual void handle_stubborn_operator(const State &state, int op_no) = 0;
     virtual void compute_stubborn_set(const State &state) override;
 protected:
+    /* consumers[fact] contains all operator indices of operators
+       with the fact as a precondition. */
+    OperatorsByFact consumers;
+
     explicit StubbornSetsActionCentric(const plugins::Options &opts);
-    bool can_disable(int op1_no, int op2_no) const;
-    bool can_conflict(int op1_no, int op2_no) const;
+
+    /*
+      The following functions append to ops the indices of all operators
+      op2 such that op1 can disable op2 (an effect of op1 contradicts a
+      precondition of op2), op2 can disable op1, and op1 and op2 conflict
+      (their effects contradict each other), respectively. Instead of
+      testing all operators, we look up the operators mentioning a sibling
+      of each fact of op1, so the result may contain op1_no and duplicates.
+    */
+    void add_disabled_operators(int op1_no, std::vector<int> &ops) const;
+    void add_disabling_operators(int op1_no, std::vector<int> &ops) const;
+    void add_conflicting_operators(int op1_no, std::vector<int> &ops) const;
 
     /*
       Return the first unsatified goal pair,
@@ -34,6 +119,15 @@ protected:
 
     // Return true iff the operator was enqueued.
     bool enqueue_stubborn_operator(int op_no);
+    /*
+      Enqueue all operators in the row of op_no in relation that are not
+      stubborn yet. Dense rows are merged into the stubborn set a word at
+      a time.
+    */
+    void enqueue_stubborn_operators(
+        const LazyOperatorRelation &relation, int op_no);
+public:
+    virtual void initialize(const std::shared_ptr<AbstractTask> &task) override;
 };
 }
 
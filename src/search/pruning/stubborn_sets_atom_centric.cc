@@ -148,7 +148,7 @@ FactPair StubbornSetsAtomCentric::select_fact(
         int min_count = numeric_limits<int>::max();
         for (const FactPair &condition : facts) {
             if (state[condition.var].get_value() != condition.value) {
-                int count = achievers[condition.var][condition.value].size();
+                int count = achievers[condition].size();
                 if (count < min_count) {
                     fact = condition;
                     min_count = count;
@@ -159,9 +159,9 @@ FactPair StubbornSetsAtomCentric::select_fact(
         int min_count = numeric_limits<int>::max();
         for (const FactPair &condition : facts) {
             if (state[condition.var].get_value() != condition.value) {
-                const vector<int> &ops = achievers[condition.var][condition.value];
+                span<const int> ops = achievers[condition];
                 int count = count_if(
-                    ops.begin(), ops.end(), [&](int op) {return !stubborn[op];});
+                    ops.begin(), ops.end(), [&](int op) {return !is_stubborn(op);});
                 if (count < min_count) {
                     fact = condition;
                     min_count = count;
@@ -218,7 +218,7 @@ void StubbornSetsAtomCentric::compute_stubborn_set(const State &state) {
         if (!producer_queue.empty()) {
             FactPair fact = producer_queue.back();
             producer_queue.pop_back();
-            for (int op : achievers[fact.var][fact.value]) {
+            for (int op : achievers[fact]) {
                 handle_stubborn_operator(state, op);
             }
         } else {
@@ -232,8 +232,7 @@ void StubbornSetsAtomCentric::compute_stubborn_set(const State &state) {
 }
 
 void StubbornSetsAtomCentric::handle_stubborn_operator(const State &state, int op) {
-    if (!stubborn[op]) {
-        stubborn[op] = true;
+    if (mark_stubborn(op)) {
         if (operator_is_applicable(op, state)) {
             enqueue_interferers(op);
         } else {
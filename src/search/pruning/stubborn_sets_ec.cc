@@ -107,7 +107,7 @@ StubbornSetsEC::StubbornSetsEC(const plugins::Options &opts)
 }
 
 void StubbornSetsEC::initialize(const shared_ptr<AbstractTask> &task) {
-    StubbornSets::initialize(task);
+    StubbornSetsActionCentric::initialize(task);
     TaskProxy task_proxy(*task);
     VariablesProxy variables = task_proxy.get_variables();
     written_vars.assign(variables.size(), false);
@@ -115,14 +115,12 @@ void StubbornSetsEC::initialize(const shared_ptr<AbstractTask> &task) {
         variables, [](const VariableProxy &var) {
             return vector<bool>(var.get_domain_size(), false);
         });
-    active_ops.assign(num_operators, false);
+    active_ops.assign((num_operators + 63) / 64, 0);
     compute_operator_preconditions(task_proxy);
     build_reachability_map(task_proxy);
 
-    conflicting_and_disabling.resize(num_operators);
-    conflicting_and_disabling_computed.resize(num_operators, false);
-    disabled.resize(num_operators);
-    disabled_computed.resize(num_operators, false);
+    conflicting_and_disabling.initialize(num_operators);
+    disabled.initialize(num_operators);
 
     log << "pruning method: stubborn sets ec" << endl;
 }
@@ -157,7 +155,7 @@ void StubbornSetsEC::build_reachability_map(const TaskProxy &task_proxy) {
 }
 
 void StubbornSetsEC::compute_active_operators(const State &state) {
-    active_ops.assign(active_ops.size(), false);
+    active_ops.assign(active_ops.size(), 0);
 
     for (int op_no = 0; op_no < num_operators; ++op_no) {
         bool all_preconditions_are_active = true;
@@ -174,41 +172,28 @@ void StubbornSetsEC::compute_active_operators(const State &state) {
         }
 
         if (all_preconditions_are_active) {
-            active_ops[op_no] = true;
+            active_ops[op_no / 64] |= uint64_t(1) << (op_no % 64);
         }
     }
 }
 
-const vector<int> &StubbornSetsEC::get_conflicting_and_disabling(int op1_no) {
-    vector<int> &result = conflicting_and_disabling[op1_no];
-    if (!conflicting_and_disabling_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op1_no != op2_no) {
-                bool conflict = can_conflict(op1_no, op2_no);
-                bool disable = can_disable(op2_no, op1_no);
-                if (conflict || disable) {
-                    result.push_back(op2_no);
-                }
-            }
-        }
-        result.shrink_to_fit();
-        conflicting_and_disabling_computed[op1_no] = true;
+void StubbornSetsEC::compute_conflicting_and_disabling(int op1_no) {
+    if (!conflicting_and_disabling.has_row(op1_no)) {
+        vector<int> &result = relation_buffer;
+        result.clear();
+        add_conflicting_operators(op1_no, result);
+        add_disabling_operators(op1_no, result);
+        conflicting_and_disabling.set_row(op1_no, result);
     }
-    return result;
 }
 
-const vector<int> &StubbornSetsEC::get_disabled(int op1_no) {
-    vector<int> &result = disabled[op1_no];
-    if (!disabled_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op2_no != op1_no && can_disable(op1_no, op2_no)) {
-                result.push_back(op2_no);
-            }
-        }
-        result.shrink_to_fit();
-        disabled_computed[op1_no] = true;
+void StubbornSetsEC::compute_disabled(int op1_no) {
+    if (!disabled.has_row(op1_no)) {
+        vector<int> &result = relation_buffer;
+        result.clear();
+        add_disabled_operators(op1_no, result);
+        disabled.set_row(op1_no, result);
     }
-    return result;
 }
 
 bool StubbornSetsEC::is_applicable(int op_no, const State &state) const {
@@ -229,8 +214,8 @@ void StubbornSetsEC::enqueue_stubborn_operator_and_remember_written_vars(
 /* TODO: think about a better name, which distinguishes this method
    better from the corresponding method for simple stubborn sets */
 void StubbornSetsEC::add_nes_for_fact(const FactPair &fact, const State &state) {
-    for (int achiever : achievers[fact.var][fact.value]) {
-        if (active_ops[achiever]) {
+    for (int achiever : achievers[fact]) {
+        if (is_active(achiever)) {
             enqueue_stubborn_operator_and_remember_written_vars(achiever, state);
         }
     }
@@ -240,11 +225,11 @@ void StubbornSetsEC::add_nes_for_fact(const FactPair &fact, const State &state)
 
 void StubbornSetsEC::add_conflicting_and_disabling(int op_no,
                                                    const State &state) {
-    for (int conflict : get_conflicting_and_disabling(op_no)) {
-        if (active_ops[conflict]) {
+    compute_conflicting_and_disabling(op_no);
+    conflicting_and_disabling.for_each_operator(
+        op_no, active_ops, [&](int conflict) {
             enqueue_stubborn_operator_and_remember_written_vars(conflict, state);
-        }
-    }
+        });
 }
 
 // Relies on op_effects and op_preconditions being sorted by variable.
@@ -293,31 +278,30 @@ void StubbornSetsEC::handle_stubborn_operator(const State &state, int op_no) {
         add_conflicting_and_disabling(op_no, state);     // active operators used
         //Rule S4'
         vector<int> disabled_vars;
-        for (int disabled_op_no : get_disabled(op_no)) {
-            if (active_ops[disabled_op_no]) {
-                get_disabled_vars(op_no, disabled_op_no, disabled_vars);
-                if (!disabled_vars.empty()) {     // == can_disable(op1_no, op2_no)
-                    bool v_applicable_op_found = false;
-                    for (int disabled_var : disabled_vars) {
-                        //First case: add o'
-                        if (is_v_applicable(disabled_var,
-                                            disabled_op_no,
-                                            state,
-                                            op_preconditions_on_var)) {
-                            enqueue_stubborn_operator_and_remember_written_vars(
-                                disabled_op_no, state);
-                            v_applicable_op_found = true;
-                            break;
-                        }
+        compute_disabled(op_no);
+        disabled.for_each_operator(op_no, active_ops, [&](int disabled_op_no) {
+            get_disabled_vars(op_no, disabled_op_no, disabled_vars);
+            if (!disabled_vars.empty()) {     // == can_disable(op1_no, op2_no)
+                bool v_applicable_op_found = false;
+                for (int disabled_var : disabled_vars) {
+                    //First case: add o'
+                    if (is_v_applicable(disabled_var,
+                                        disabled_op_no,
+                                        state,
+                                        op_preconditions_on_var)) {
+                        enqueue_stubborn_operator_and_remember_written_vars(
+                            disabled_op_no, state);
+                        v_applicable_op_found = true;
+                        break;
                     }
+                }
 
-                    //Second case: add a necessary enabling set for o' following S5
-                    if (!v_applicable_op_found) {
-                        apply_s5(disabled_op_no, state);
-                    }
+                //Second case: add a necessary enabling set for o' following S5
+                if (!v_applicable_op_found) {
+                    apply_s5(disabled_op_no, state);
                 }
             }
-        }
+        });
     } else {     // op is inapplicable
         //S5
         apply_s5(op_no, state);
@@ -8,11 +8,11 @@ class StubbornSetsEC : public stubborn_sets::StubbornSetsActionCentric {
 private:
     std::vector<std::vector<std::vector<bool>>> reachability_map;
     std::vector<std::vector<int>> op_preconditions_on_var;
-    std::vector<bool> active_ops;
-    std::vector<std::vector<int>> conflicting_and_disabling;
-    std::vector<bool> conflicting_and_disabling_computed;
-    std::vector<std::vector<int>> disabled;
-    std::vector<bool> disabled_computed;
+    // Bit op_no of active_ops is set iff the operator is active.
+    std::vector<uint64_t> active_ops;
+    stubborn_sets::LazyOperatorRelation conflicting_and_disabling;
+    stubborn_sets::LazyOperatorRelation disabled;
+    std::vector<int> relation_buffer;
     std::vector<bool> written_vars;
     std::vector<std::vector<bool>> nes_computed;
 
@@ -21,8 +21,11 @@ private:
                            std::vector<int> &disabled_vars) const;
     void build_reachability_map(const TaskProxy &task_proxy);
     void compute_operator_preconditions(const TaskProxy &task_proxy);
-    const std::vector<int> &get_conflicting_and_disabling(int op1_no);
-    const std::vector<int> &get_disabled(int op1_no);
+    void compute_conflicting_and_disabling(int op1_no);
+    void compute_disabled(int op1_no);
+    bool is_active(int op_no) const {
+        return (active_ops[op_no / 64] >> (op_no % 64)) & 1;
+    }
     void add_conflicting_and_disabling(int op_no, const State &state);
     void compute_active_operators(const State &state);
     void enqueue_stubborn_operator_and_remember_written_vars(int op_no, const State &state);
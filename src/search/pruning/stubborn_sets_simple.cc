@@ -12,43 +12,39 @@ StubbornSetsSimple::StubbornSetsSimple(const plugins::Options &opts)
 }
 
 void StubbornSetsSimple::initialize(const shared_ptr<AbstractTask> &task) {
-    StubbornSets::initialize(task);
-    interference_relation.resize(num_operators);
-    interference_relation_computed.resize(num_operators, false);
+    StubbornSetsActionCentric::initialize(task);
+    interference_relation.initialize(num_operators);
     log << "pruning method: stubborn sets simple" << endl;
 }
 
-const vector<int> &StubbornSetsSimple::get_interfering_operators(int op1_no) {
+void StubbornSetsSimple::compute_interfering_operators(int op1_no) {
     /*
-       TODO: as interference is symmetric, we only need to compute the
-       relation for operators (o1, o2) with (o1 < o2) and add a lookup
-       method that looks up (i, j) if i < j and (j, i) otherwise.
+      Operators interfere if one can disable the other or if they conflict.
+      We only compute the relation for operators that become stubborn and
+      applicable and only consider operators mentioning a sibling of a fact
+      in op1, so we never have to loop over all pairs of operators.
     */
-    vector<int> &interfere_op1 = interference_relation[op1_no];
-    if (!interference_relation_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op1_no != op2_no && interfere(op1_no, op2_no)) {
-                interfere_op1.push_back(op2_no);
-            }
-        }
-        interfere_op1.shrink_to_fit();
-        interference_relation_computed[op1_no] = true;
+    if (!interference_relation.has_row(op1_no)) {
+        vector<int> &interfere_op1 = interfering_operators_buffer;
+        interfere_op1.clear();
+        add_disabled_operators(op1_no, interfere_op1);
+        add_conflicting_operators(op1_no, interfere_op1);
+        add_disabling_operators(op1_no, interfere_op1);
+        interference_relation.set_row(op1_no, interfere_op1);
     }
-    return interfere_op1;
 }
 
 // Add all operators that achieve the fact (var, value) to stubborn set.
 void StubbornSetsSimple::add_necessary_enabling_set(const FactPair &fact) {
-    for (int op_no : achievers[fact.var][fact.value]) {
+    for (int op_no : achievers[fact]) {
         enqueue_stubborn_operator(op_no);
     }
 }
 
 // Add all operators that interfere with op.
 void StubbornSetsSimple::add_interfering(int op_no) {
-    for (int interferer_no : get_interfering_operators(op_no)) {
-        enqueue_stubborn_operator(interferer_no);
-    }
+    compute_interfering_operators(op_no);
+    enqueue_stubborn_operators(interference_relation, op_no);
 }
 
 void StubbornSetsSimple::initialize_stubborn_set(const State &state) {
@@ -7,20 +7,15 @@ namespace stubborn_sets_simple {
 /* Implementation of simple instantiation of strong stubborn sets.
    Disjunctive action landmarks are computed trivially.*/
 class StubbornSetsSimple : public stubborn_sets::StubbornSetsActionCentric {
-    /* interference_relation[op1_no] contains all operator indices
-       of operators that interfere with op1. */
-    std::vector<std::vector<int>> interference_relation;
-    std::vector<bool> interference_relation_computed;
+    /* The row of op1_no in interference_relation contains all operator
+       indices of operators that interfere with op1. */
+    stubborn_sets::LazyOperatorRelation interference_relation;
+    std::vector<int> interfering_operators_buffer;
 
     void add_necessary_enabling_set(const FactPair &fact);
     void add_interfering(int op_no);
 
-    inline bool interfere(int op1_no, int op2_no) {
-        return can_disable(op1_no, op2_no) ||
-               can_conflict(op1_no, op2_no) ||
-               can_disable(op2_no, op1_no);
-    }
-    const std::vector<int> &get_interfering_operators(int op1_no);
+    void compute_interfering_operators(int op1_no);
 protected:
     virtual void initialize_stubborn_set(const State &state) override;
     virtual void handle_stubborn_operator(const State &state,
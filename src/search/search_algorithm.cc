@@ -13,6 +13,7 @@
 #include "utils/system.h"
 #include "utils/timer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <limits>
@@ -53,7 +54,8 @@ SearchAlgorithm::SearchAlgorithm(const plugins::Options &opts)
       statistics(log),
       cost_type(opts.get<OperatorCost>("cost_type")),
       is_unit_cost(task_properties::is_unit_cost(task_proxy)),
-      max_time(opts.get<double>("max_time")) {
+      max_time(opts.get<double>("max_time")),
+      solution_sharing(nullptr) {
     if (opts.get<int>("bound") < 0) {
         cerr << "error: negative cost bound " << opts.get<int>("bound") << endl;
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
@@ -81,6 +83,15 @@ const Plan &SearchAlgorithm::get_plan() const {
 void SearchAlgorithm::set_plan(const Plan &p) {
     solution_found = true;
     plan = p;
+    if (solution_sharing) {
+        solution_sharing->report_plan(plan);
+    }
+}
+
+void SearchAlgorithm::save_intermediate_plan(const Plan &plan) {
+    if (!solution_sharing) {
+        plan_manager.save_plan(plan, task_proxy, true);
+    }
 }
 
 void SearchAlgorithm::search() {
@@ -93,6 +104,16 @@ void SearchAlgorithm::search() {
             status = TIMEOUT;
             break;
         }
+        if (solution_sharing) {
+            bound = min(bound, solution_sharing->get_shared_bound());
+        }
+        if (status == IN_PROGRESS && solution_sharing &&
+            solution_sharing->is_stop_requested()) {
+            // The search is incomplete, so we report it like a timeout.
+            log << "Stop requested by portfolio. Abort search." << endl;
+            status = TIMEOUT;
+            break;
+        }
     }
     // TODO: Revise when and which search times are logged.
     log << "Actual search time: " << timer.get_elapsed_time() << endl;
@@ -30,6 +30,21 @@ class SuccessorGenerator;
 
 // enum SearchStatus {IN_PROGRESS = -1, TIMEOUT = -2, FAILED = -3, SOLVED = -4};
 enum SearchStatus {IN_PROGRESS, TIMEOUT, FAILED, SOLVED};
+
+/*
+  Interface through which searches running in a parallel portfolio share
+  their plans. Searches report each plan as soon as they find it and poll
+  the cost of the best plan of all searches and whether they should stop
+  after each step. All methods may be called from several threads.
+*/
+class SolutionSharing {
+public:
+    virtual ~SolutionSharing() = default;
+    virtual void report_plan(const Plan &plan) = 0;
+    virtual int get_shared_bound() const = 0;
+    virtual bool is_stop_requested() const = 0;
+};
+
 class SearchAlgorithm {
     std::string description;
     SearchStatus status;
@@ -53,11 +68,19 @@ protected:
     bool is_unit_cost;
     double max_time;
 
+    // nullptr for searches outside of parallel portfolios.
+    SolutionSharing *solution_sharing;
+
     virtual void initialize() {}
     virtual SearchStatus step() = 0;
 
     void set_plan(const Plan &plan);
     bool check_goal_and_set_plan(const State &state);
+    /*
+      Save a plan found before the search ends (e.g., by an anytime search).
+      Parallel portfolios save the plans of their searches themselves.
+    */
+    void save_intermediate_plan(const Plan &plan);
     int get_adjusted_cost(const OperatorProxy &op) const;
 public:
     SearchAlgorithm(const plugins::Options &opts);
@@ -70,6 +93,9 @@ public:
     void search();
     const SearchStatistics &get_statistics() const {return statistics;}
     void set_bound(int b) {bound = b;}
+    void set_solution_sharing(SolutionSharing *solution_sharing_) {
+        solution_sharing = solution_sharing_;
+    }
     int get_bound() {return bound;}
     PlanManager &get_plan_manager() {return plan_manager;}
     std::string get_description() {return description;}
@@ -0,0 +1,314 @@
+#include "anytime_search.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+
+#include "../plugins/plugin.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+#include <set>
+
+using namespace std;
+
+namespace anytime_search {
+AnytimeSearch::AnytimeSearch(const plugins::Options &opts)
+    : SearchAlgorithm(opts),
+      evaluator(opts.get<shared_ptr<Evaluator>>("eval")),
+      weights(opts.get_list<int>("weights")),
+      restart(opts.get<bool>("restart")),
+      phase(0) {
+}
+
+int AnytimeSearch::get_epoch() const {
+    return restart ? phase : 0;
+}
+
+void AnytimeSearch::push(const SearchNode &node, int h) {
+    int g = node.get_g();
+    open_heap.emplace_back(g + weights[phase] * h, h, g, node.get_state().get_id());
+    push_heap(open_heap.begin(), open_heap.end());
+}
+
+bool AnytimeSearch::evaluate(const State &state, int g, AnytimeNodeInfo &info) {
+    /*
+      Compute the heuristic value of the state unless it is known from
+      an earlier phase. Return false if the state is a dead end.
+    */
+    if (info.h == -1) {
+        EvaluationContext eval_context(state, g, false, &statistics);
+        statistics.inc_evaluated_states();
+        if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+            return false;
+        }
+        info.h = eval_context.get_evaluator_value(evaluator.get());
+    }
+    return true;
+}
+
+void AnytimeSearch::open_initial_state() {
+    const State &initial_state = state_registry.get_initial_state();
+    SearchNode node = search_space.get_node(initial_state);
+    AnytimeNodeInfo &info = node_infos[initial_state];
+    if (node.is_dead_end()) {
+        return;
+    }
+    if (!evaluate(initial_state, 0, info)) {
+        log << "Initial state is a dead end." << endl;
+        node.mark_as_dead_end();
+        statistics.inc_dead_ends();
+        return;
+    }
+    // The initial state always has g-value 0 and no parent.
+    if (node.is_new()) {
+        node.open_initial();
+    }
+    info.epoch = get_epoch();
+    push(node, info.h);
+}
+
+void AnytimeSearch::initialize() {
+    log << "Conducting anytime weighted A* search"
+        << (restart ? " with" : " without") << " restarts, weights = "
+        << weights << ", (real) bound = " << bound << endl;
+
+    set<Evaluator *> path_dependent_evaluators;
+    evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "Anytime search does not support path-dependent evaluators."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+
+    log << "Starting phase with weight " << weights[phase] << endl;
+    open_initial_state();
+}
+
+void AnytimeSearch::expand(const SearchNode &node) {
+    const State &s = node.get_state();
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(s, applicable_ops);
+
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        if ((node.get_real_g() + op.get_cost()) >= bound)
+            continue;
+
+        State succ_state = state_registry.get_successor_state(s, op);
+        statistics.inc_generated();
+        SearchNode succ_node = search_space.get_node(succ_state);
+        if (succ_node.is_dead_end())
+            continue;
+
+        AnytimeNodeInfo &succ_info = node_infos[succ_state];
+        int succ_g = node.get_g() + get_adjusted_cost(op);
+        if (!evaluate(succ_state, succ_g, succ_info)) {
+            succ_node.mark_as_dead_end();
+            statistics.inc_dead_ends();
+            continue;
+        }
+
+        if (succ_info.epoch != get_epoch()) {
+            // We have not reached this state in this epoch.
+            succ_info.epoch = get_epoch();
+            succ_node.open(node, op, get_adjusted_cost(op));
+            push(succ_node, succ_info.h);
+        } else if (succ_g < succ_node.get_g()) {
+            // We found a new cheapest path to an open or closed state.
+            if (succ_info.closed_phase == phase && !is_last_phase()) {
+                /*
+                  Like ARA*, we do not expand states twice in a phase.
+                  They are reopened when the next phase starts. In the
+                  last phase, we reopen them right away like A*, so that
+                  its plan is optimal for weight 1 and admissible h.
+                */
+                succ_node.update_parent(node, op, get_adjusted_cost(op));
+                inconsistent_states.push_back(succ_state.get_id());
+            } else {
+                if (succ_info.closed_phase == phase) {
+                    // Allow expanding the state again in the last phase.
+                    succ_info.closed_phase = -1;
+                }
+                succ_node.reopen(node, op, get_adjusted_cost(op));
+                push(succ_node, succ_info.h);
+            }
+            statistics.inc_reopened();
+        }
+    }
+}
+
+void AnytimeSearch::save_improving_plan(const State &goal_state) {
+    Plan plan;
+    search_space.trace_path(goal_state, plan);
+    int plan_cost = calculate_plan_cost(plan, task_proxy);
+    /*
+      Successors that reach the bound are pruned, but the bound may have
+      been lowered (e.g., by a parallel portfolio) after the goal was reached.
+    */
+    if (plan_cost < bound) {
+        save_intermediate_plan(plan);
+        bound = plan_cost;
+        set_plan(plan);
+    }
+    if (found_solution())
+        log << "Best solution cost so far: " << bound << endl;
+}
+
+bool AnytimeSearch::is_last_phase() const {
+    return phase + 1 == static_cast<int>(weights.size());
+}
+
+void AnytimeSearch::start_next_phase() {
+    ++phase;
+    log << "Starting phase with weight " << weights[phase] << endl;
+    vector<OpenEntry> old_entries;
+    old_entries.swap(open_heap);
+    vector<StateID> reopened_states;
+    reopened_states.swap(inconsistent_states);
+    if (restart) {
+        open_initial_state();
+        return;
+    }
+
+    /*
+      Like ARA*, we continue with the open states and the states whose
+      g-value decreased after their expansion, and prioritize them with
+      the new weight. We drop entries with outdated g-values and entries
+      of states that were expanded in the previous phase.
+    */
+    for (const OpenEntry &entry : old_entries) {
+        State s = state_registry.lookup_state(entry.id);
+        SearchNode node = search_space.get_node(s);
+        if (entry.g == node.get_g() && node_infos[s].closed_phase != phase - 1) {
+            open_heap.emplace_back(
+                entry.g + weights[phase] * entry.h, entry.h, entry.g, entry.id);
+        }
+    }
+    for (StateID id : reopened_states) {
+        State s = state_registry.lookup_state(id);
+        SearchNode node = search_space.get_node(s);
+        int h = node_infos[s].h;
+        open_heap.emplace_back(
+            node.get_g() + weights[phase] * h, h, node.get_g(), id);
+    }
+    make_heap(open_heap.begin(), open_heap.end());
+}
+
+SearchStatus AnytimeSearch::step() {
+    while (!open_heap.empty()) {
+        pop_heap(open_heap.begin(), open_heap.end());
+        OpenEntry entry = open_heap.back();
+        open_heap.pop_back();
+
+        State s = state_registry.lookup_state(entry.id);
+        SearchNode node = search_space.get_node(s);
+        AnytimeNodeInfo &info = node_infos[s];
+        if (info.closed_phase == phase || entry.g != node.get_g())
+            continue;
+        info.closed_phase = phase;
+        if (node.is_open())
+            node.close();
+        statistics.inc_expanded();
+
+        if (task_properties::is_goal_state(task_proxy, s)) {
+            log << "Solution found!" << endl;
+            save_improving_plan(s);
+            if (is_last_phase()) {
+                log << "Finished phase with the last weight." << endl;
+                return SOLVED;
+            }
+            start_next_phase();
+        } else {
+            expand(node);
+        }
+        return IN_PROGRESS;
+    }
+
+    if (!inconsistent_states.empty()) {
+        /*
+          The phase ran out of open states before reaching a goal, but
+          some expanded states were reached with lower g-values since.
+          Their successors may lead to cheaper plans, so we continue with
+          them in the next phase. (Only phases before the last one defer
+          reopened states.)
+        */
+        assert(!is_last_phase());
+        start_next_phase();
+        return IN_PROGRESS;
+    }
+
+    if (found_solution()) {
+        log << "Completely explored state space below the cost of the "
+            << "best plan -- the plan is optimal." << endl;
+        return SOLVED;
+    }
+    log << "Completely explored state space -- no solution!" << endl;
+    return FAILED;
+}
+
+void AnytimeSearch::print_statistics() const {
+    log << "Number of phases: " << phase + 1 << endl;
+    statistics.print_detailed_statistics();
+    search_space.print_statistics();
+}
+
+void AnytimeSearch::save_plan_if_necessary() {
+    // We don't need to save here, as we save each plan when we find it.
+}
+
+class AnytimeSearchFeature
+    : public plugins::TypedFeature<SearchAlgorithm, AnytimeSearch> {
+public:
+    AnytimeSearchFeature() : TypedFeature("anytime_wastar") {
+        document_title("Anytime weighted A* search");
+        document_synopsis(
+            "Runs weighted A* with each of the given weights in turn. Each "
+            "phase ends when a goal state is expanded, and every plan it "
+            "finds is cheaper than the plans of the earlier phases. Unlike "
+            "iterated search with weighted A* phases, all phases share the "
+            "search space and the heuristic values, so states are evaluated "
+            "at most once. Without restarts, this is Anytime Repairing A* "
+            "(ARA*); with restarts, it is Restarting Weighted A* (RWA*).");
+
+        add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+        add_list_option<int>(
+            "weights",
+            "weights of the heuristic in the phases, one phase per weight. "
+            "Weights should decrease and must be at least 1.",
+            "[5, 3, 2, 1]");
+        add_option<bool>(
+            "restart",
+            "start each phase from the initial state (RWA*) instead of "
+            "continuing with the open and inconsistent states of the "
+            "previous phase (ARA*)",
+            "false");
+        SearchAlgorithm::add_options_to_feature(*this);
+
+        document_note(
+            "Optimality",
+            "If the last weight is 1 and the heuristic is admissible, the "
+            "last plan is optimal. The search also ends with an optimal plan "
+            "(for a safe heuristic) if it runs out of open states and of "
+            "states whose g-value decreased after their expansion, since it "
+            "then has considered all paths that are cheaper than the best "
+            "plan.");
+    }
+
+    virtual shared_ptr<AnytimeSearch> create_component(
+        const plugins::Options &options,
+        const utils::Context &context) const override {
+        plugins::verify_list_non_empty<int>(context, options, "weights");
+        for (int weight : options.get_list<int>("weights")) {
+            if (weight < 1) {
+                context.error("Weights must be at least 1.");
+            }
+        }
+        return make_shared<AnytimeSearch>(options);
+    }
+};
+
+static plugins::FeaturePlugin<AnytimeSearchFeature> _plugin;
+}
@@ -0,0 +1,95 @@
+#ifndef SEARCH_ALGORITHMS_ANYTIME_SEARCH_H
+#define SEARCH_ALGORITHMS_ANYTIME_SEARCH_H
+
+#include "../per_state_information.h"
+#include "../search_algorithm.h"
+
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace anytime_search {
+/*
+  Anytime weighted A* that runs one phase per weight on the same search
+  space. Unlike iterated search, all phases share the state registry, the
+  search nodes and the heuristic values, so each state is evaluated at most
+  once.
+
+  Without restarts, this is Anytime Repairing A* (Likhachev et al., 2004):
+  when a phase ends, the states that are still open and the closed states
+  whose g-value decreased after their expansion are reinserted with the
+  priorities of the next weight. The last phase reopens states right away
+  like A*. With restarts, this is Restarting
+  Weighted A* (Richter et al., 2010): each phase starts from the initial
+  state but reuses the heuristic values of all states seen before.
+*/
+class AnytimeSearch : public SearchAlgorithm {
+    struct OpenEntry {
+        int key;
+        int h;
+        int g;
+        StateID id;
+
+        OpenEntry(int key, int h, int g, StateID id)
+            : key(key), h(h), g(g), id(id) {
+        }
+
+        // Order for a max-heap that puts the entry with minimal key on top.
+        bool operator<(const OpenEntry &other) const {
+            if (key != other.key)
+                return key > other.key;
+            return h > other.h;
+        }
+    };
+
+    struct AnytimeNodeInfo {
+        // Heuristic value of the state, or -1 if it has not been evaluated.
+        int h;
+        /*
+          The search node of the state is only valid if epoch is equal to
+          get_epoch(). With restarts, the epoch changes with every phase.
+        */
+        int epoch;
+        // Last phase in which the state was expanded, or -1 if it was not
+        // expanded or was reopened in the last phase.
+        int closed_phase;
+
+        AnytimeNodeInfo()
+            : h(-1), epoch(-1), closed_phase(-1) {
+        }
+    };
+
+    std::shared_ptr<Evaluator> evaluator;
+    std::vector<int> weights;
+    bool restart;
+
+    int phase;
+    PerStateInformation<AnytimeNodeInfo> node_infos;
+    // Binary heap of open states ordered by g + w * h.
+    std::vector<OpenEntry> open_heap;
+    // States whose g-value decreased after their expansion in this phase.
+    std::vector<StateID> inconsistent_states;
+
+    int get_epoch() const;
+    void push(const SearchNode &node, int h);
+    void open_initial_state();
+    bool evaluate(const State &state, int g, AnytimeNodeInfo &info);
+    void expand(const SearchNode &node);
+    void save_improving_plan(const State &goal_state);
+    void start_next_phase();
+    bool is_last_phase() const;
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit AnytimeSearch(const plugins::Options &opts);
+
+    virtual void save_plan_if_necessary() override;
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
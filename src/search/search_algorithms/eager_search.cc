@@ -7,7 +7,9 @@
 
 #include "../algorithms/ordered_set.h"
 #include "../plugins/options.h"
+#include "../structural_symmetries/structural_symmetries.h"
 #include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
 
 #include <cassert>
@@ -27,7 +29,9 @@ EagerSearch::EagerSearch(const plugins::Options &opts)
       f_evaluator(opts.get<shared_ptr<Evaluator>>("f_eval", nullptr)),
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       lazy_evaluator(opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr)),
-      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")) {
+      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      symmetries(opts.get<shared_ptr<structural_symmetries::StructuralSymmetries>>(
+                     "symmetries", nullptr)) {
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
@@ -71,6 +75,19 @@ void EagerSearch::initialize() {
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
+    if (symmetries) {
+        /*
+          Path-dependent evaluators would be notified about transitions to
+          canonical representatives, which are not actual transitions.
+        */
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "Orbit search does not support path-dependent evaluators."
+                 << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+        symmetries->initialize(task);
+    }
+
     State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
@@ -168,8 +185,17 @@ SearchStatus EagerSearch::step() {
     }
 
     const State &s = node->get_state();
-    if (check_goal_and_set_plan(s))
+    if (task_properties::is_goal_state(task_proxy, s)) {
+        log << "Solution found!" << endl;
+        Plan plan;
+        search_space.trace_path(s, plan);
+        if (symmetries) {
+            // Set only the plan for the original task, which may be shared.
+            plan = symmetries->compute_unpermuted_plan(plan);
+        }
+        set_plan(plan);
         return SOLVED;
+    }
 
     vector<OperatorID> applicable_ops;
     successor_generator.generate_applicable_ops(s, applicable_ops);
@@ -194,7 +220,9 @@ SearchStatus EagerSearch::step() {
         if ((node->get_real_g() + op.get_cost()) >= bound)
             continue;
 
-        State succ_state = state_registry.get_successor_state(s, op);
+        State succ_state = symmetries ?
+            symmetries->get_canonical_successor_state(state_registry, s, op) :
+            state_registry.get_successor_state(s, op);
         statistics.inc_generated();
         bool is_preferred = preferred_operators.contains(op_id);
 
@@ -219,6 +247,7 @@ SearchStatus EagerSearch::step() {
 
             EvaluationContext succ_eval_context(
                 succ_state, succ_g, is_preferred, &statistics);
+            succ_eval_context.set_parent_state_id(s.get_id());
             statistics.inc_evaluated_states();
 
             if (open_list->is_dead_end(succ_eval_context)) {
@@ -250,6 +279,7 @@ SearchStatus EagerSearch::step() {
 
                 EvaluationContext succ_eval_context(
                     succ_state, succ_node.get_g(), is_preferred, &statistics);
+                succ_eval_context.set_parent_state_id(s.get_id());
 
                 /*
                   Note: our old code used to retrieve the h value from
@@ -309,6 +339,7 @@ void EagerSearch::update_f_value_statistics(EvaluationContext &eval_context) {
 
 void add_options_to_feature(plugins::Feature &feature) {
     SearchAlgorithm::add_pruning_option(feature);
+    structural_symmetries::add_symmetries_option_to_feature(feature);
     SearchAlgorithm::add_options_to_feature(feature);
 }
 }
@@ -14,6 +14,10 @@ namespace plugins {
 class Feature;
 }
 
+namespace structural_symmetries {
+class StructuralSymmetries;
+}
+
 namespace eager_search {
 class EagerSearch : public SearchAlgorithm {
     const bool reopen_closed_nodes;
@@ -26,6 +30,7 @@ class EagerSearch : public SearchAlgorithm {
     std::shared_ptr<Evaluator> lazy_evaluator;
 
     std::shared_ptr<PruningMethod> pruning_method;
+    std::shared_ptr<structural_symmetries::StructuralSymmetries> symmetries;
 
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(EvaluationContext &eval_context);
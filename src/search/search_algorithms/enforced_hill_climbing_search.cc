@@ -71,6 +71,8 @@ EnforcedHillClimbingSearch::EnforcedHillClimbingSearch(
       evaluator(opts.get<shared_ptr<Evaluator>>("h")),
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       preferred_usage(opts.get<PreferredUsage>("preferred_usage")),
+      revisit_states(opts.get<bool>("revisit_states")),
+      lookahead(opts.get<int>("lookahead")),
       current_eval_context(state_registry.get_initial_state(), &statistics),
       current_phase_start_g(-1),
       num_ehc_phases(0),
@@ -124,8 +126,12 @@ void EnforcedHillClimbingSearch::initialize() {
             utils::exit_with(ExitCode::SEARCH_UNSOLVED_INCOMPLETE);
     }
 
-    SearchNode node = search_space.get_node(current_eval_context.get_state());
+    const State &initial_state = current_eval_context.get_state();
+    SearchNode node = search_space.get_node(initial_state);
     node.open_initial();
+    EHCNodeInfo &info = ehc_node_infos[initial_state];
+    info.h = current_eval_context.get_evaluator_value(evaluator.get());
+    info.on_path = true;
 
     current_phase_start_g = 0;
 }
@@ -181,6 +187,117 @@ void EnforcedHillClimbingSearch::expand(EvaluationContext &eval_context) {
     node.close();
 }
 
+bool EnforcedHillClimbingSearch::is_reached_in_current_phase(
+    const EHCNodeInfo &info) const {
+    /*
+      By default, the breadth-first searches of all phases share one closed
+      list. With revisit_states, each phase has its own closed list, but we
+      never revisit the states on the path to the current phase's start.
+    */
+    if (info.on_path)
+        return true;
+    return revisit_states ? info.phase == num_ehc_phases : info.phase != -1;
+}
+
+void EnforcedHillClimbingSearch::start_phase(
+    EvaluationContext &&eval_context, const SearchNode &node) {
+    ++num_ehc_phases;
+    // d: distance from the start of the previous phase
+    int d = node.get_g() - current_phase_start_g;
+    if (d_counts.count(d) == 0) {
+        d_counts[d] = make_pair(0, 0);
+    }
+    pair<int, int> &d_pair = d_counts[d];
+    d_pair.first += 1;
+    d_pair.second += statistics.get_expanded() - last_num_expanded;
+
+    // Mark the path from the start of the previous phase to the new start.
+    State state = node.get_state();
+    while (!ehc_node_infos[state].on_path) {
+        ehc_node_infos[state].on_path = true;
+        state = state_registry.lookup_state(
+            search_space.get_node(state).get_parent_state_id());
+    }
+
+    current_eval_context = move(eval_context);
+    open_list->clear();
+    lookahead_eval_contexts.clear();
+    current_phase_start_g = node.get_g();
+}
+
+bool EnforcedHillClimbingSearch::follow_preferred_operators() {
+    /*
+      Starting from the current state, repeatedly apply the first preferred
+      operator that leads to a state that was never evaluated, for up to
+      lookahead steps. If this reaches a state with a lower heuristic value,
+      start a new phase there and return true.
+    */
+    int start_h = current_eval_context.get_evaluator_value(evaluator.get());
+    EvaluationContext eval_context = current_eval_context;
+    for (int step = 0; step < lookahead; ++step) {
+        ordered_set::OrderedSet<OperatorID> preferred_operators;
+        for (const shared_ptr<Evaluator> &preferred_operator_evaluator : preferred_operator_evaluators) {
+            collect_preferred_operators(eval_context,
+                                        preferred_operator_evaluator.get(),
+                                        preferred_operators);
+        }
+        const State &parent_state = eval_context.get_state();
+        SearchNode parent_node = search_space.get_node(parent_state);
+        bool found_successor = false;
+        for (OperatorID op_id : preferred_operators) {
+            OperatorProxy op = task_proxy.get_operators()[op_id];
+            if (parent_node.get_real_g() + op.get_cost() >= bound)
+                continue;
+            State state = state_registry.get_successor_state(parent_state, op);
+            statistics.inc_generated();
+            SearchNode node = search_space.get_node(state);
+            EHCNodeInfo &info = ehc_node_infos[state];
+            if (node.is_dead_end() || info.h != -1)
+                continue;
+
+            EvaluationContext succ_eval_context(state, &statistics, true);
+            reach_state(parent_state, op_id, state);
+            statistics.inc_evaluated_states();
+            if (succ_eval_context.is_evaluator_value_infinite(evaluator.get())) {
+                node.mark_as_dead_end();
+                statistics.inc_dead_ends();
+                continue;
+            }
+            info.h = succ_eval_context.get_evaluator_value(evaluator.get());
+            node.open(parent_node, op, get_adjusted_cost(op));
+            if (info.h < start_h) {
+                start_phase(move(succ_eval_context), node);
+                return true;
+            }
+            lookahead_eval_contexts.push_back(succ_eval_context);
+            eval_context = move(succ_eval_context);
+            found_successor = true;
+            break;
+        }
+        if (!found_successor)
+            break;
+    }
+    return false;
+}
+
+EvaluationContext EnforcedHillClimbingSearch::create_eval_context(
+    const State &state, const EHCNodeInfo &info) {
+    /*
+      States evaluated before (in an earlier phase or by the lookahead)
+      are not evaluated again, unless we need their preferred operators
+      for expanding them. For the states evaluated by the lookahead of the
+      current phase, we reuse the preferred operators computed there.
+    */
+    bool need_preferred = info.h != -1 && use_preferred;
+    if (need_preferred) {
+        for (const EvaluationContext &eval_context : lookahead_eval_contexts) {
+            if (eval_context.get_state().get_id() == state.get_id())
+                return eval_context;
+        }
+    }
+    return EvaluationContext(state, &statistics, need_preferred);
+}
+
 SearchStatus EnforcedHillClimbingSearch::step() {
     last_num_expanded = statistics.get_expanded();
     search_progress.check_progress(current_eval_context);
@@ -189,6 +306,10 @@ SearchStatus EnforcedHillClimbingSearch::step() {
         return SOLVED;
     }
 
+    if (lookahead > 0 && follow_preferred_operators()) {
+        return IN_PROGRESS;
+    }
+
     expand(current_eval_context);
     return ehc();
 }
@@ -203,10 +324,6 @@ SearchStatus EnforcedHillClimbingSearch::ehc() {
         State parent_state = state_registry.lookup_state(parent_state_id);
         SearchNode parent_node = search_space.get_node(parent_state);
 
-        // d: distance from initial node in this EHC phase
-        int d = parent_node.get_g() - current_phase_start_g +
-            get_adjusted_cost(last_op);
-
         if (parent_node.get_real_g() + last_op.get_cost() >= bound)
             continue;
 
@@ -214,33 +331,27 @@ SearchStatus EnforcedHillClimbingSearch::ehc() {
         statistics.inc_generated();
 
         SearchNode node = search_space.get_node(state);
+        EHCNodeInfo &info = ehc_node_infos[state];
 
-        if (node.is_new()) {
-            EvaluationContext eval_context(state, &statistics);
+        if (!node.is_dead_end() && !is_reached_in_current_phase(info)) {
+            info.phase = num_ehc_phases;
+            EvaluationContext eval_context = create_eval_context(state, info);
             reach_state(parent_state, last_op_id, state);
-            statistics.inc_evaluated_states();
 
-            if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
-                node.mark_as_dead_end();
-                statistics.inc_dead_ends();
-                continue;
+            if (info.h == -1) {
+                statistics.inc_evaluated_states();
+                if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+                    node.mark_as_dead_end();
+                    statistics.inc_dead_ends();
+                    continue;
+                }
+                info.h = eval_context.get_evaluator_value(evaluator.get());
             }
 
-            int h = eval_context.get_evaluator_value(evaluator.get());
             node.open(parent_node, last_op, get_adjusted_cost(last_op));
 
-            if (h < current_eval_context.get_evaluator_value(evaluator.get())) {
-                ++num_ehc_phases;
-                if (d_counts.count(d) == 0) {
-                    d_counts[d] = make_pair(0, 0);
-                }
-                pair<int, int> &d_pair = d_counts[d];
-                d_pair.first += 1;
-                d_pair.second += statistics.get_expanded() - last_num_expanded;
-
-                current_eval_context = move(eval_context);
-                open_list->clear();
-                current_phase_start_g = node.get_g();
+            if (info.h < current_eval_context.get_evaluator_value(evaluator.get())) {
+                start_phase(move(eval_context), node);
                 return IN_PROGRESS;
             } else {
                 expand(eval_context);
@@ -286,7 +397,41 @@ public:
             "preferred",
             "use preferred operators of these evaluators",
             "[]");
+        add_option<bool>(
+            "revisit_states",
+            "let the breadth-first search of each phase revisit states reached "
+            "in earlier phases, except for the states on the path to the "
+            "current state. Their heuristic values are reused. By default, "
+            "states reached in earlier phases are skipped, which can make the "
+            "search miss improving states behind them.",
+            "false");
+        add_option<int>(
+            "lookahead",
+            "before each breadth-first search, follow the first preferred "
+            "operator leading to an unevaluated state for up to this many "
+            "steps, and start the next phase right away if this reaches a "
+            "state with a lower heuristic value. Requires preferred "
+            "operators.",
+            "0",
+            plugins::Bounds("0", "infinity"));
         SearchAlgorithm::add_options_to_feature(*this);
+
+        document_note(
+            "Revisiting states",
+            "With revisit_states=true and preferred operators, expanding a "
+            "state that was evaluated in an earlier phase evaluates it again "
+            "to compute its preferred operators. Heuristic values are not "
+            "recomputed for the comparison with the current state.");
+    }
+
+    virtual shared_ptr<EnforcedHillClimbingSearch> create_component(
+        const plugins::Options &options,
+        const utils::Context &context) const override {
+        if (options.get<int>("lookahead") > 0 &&
+            options.get_list<shared_ptr<Evaluator>>("preferred").empty()) {
+            context.error("Lookahead requires preferred operators.");
+        }
+        return make_shared<EnforcedHillClimbingSearch>(options);
     }
 };
 
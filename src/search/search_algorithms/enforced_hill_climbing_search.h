@@ -3,6 +3,7 @@
 
 #include "../evaluation_context.h"
 #include "../open_list.h"
+#include "../per_state_information.h"
 #include "../search_algorithm.h"
 
 #include <map>
@@ -29,6 +30,19 @@ enum class PreferredUsage {
   the same states anyways.
 */
 class EnforcedHillClimbingSearch : public SearchAlgorithm {
+    struct EHCNodeInfo {
+        // Heuristic value of the state, or -1 if it has not been evaluated.
+        int h;
+        // Last phase whose breadth-first search reached the state, or -1.
+        int phase;
+        // True for the states on the path to the start of the current phase.
+        bool on_path;
+
+        EHCNodeInfo()
+            : h(-1), phase(-1), on_path(false) {
+        }
+    };
+
     std::unique_ptr<EdgeOpenList> open_list;
 
     std::shared_ptr<Evaluator> evaluator;
@@ -36,8 +50,13 @@ class EnforcedHillClimbingSearch : public SearchAlgorithm {
     std::set<Evaluator *> path_dependent_evaluators;
     bool use_preferred;
     PreferredUsage preferred_usage;
+    bool revisit_states;
+    int lookahead;
 
+    PerStateInformation<EHCNodeInfo> ehc_node_infos;
     EvaluationContext current_eval_context;
+    // States evaluated by the lookahead in the current phase.
+    std::vector<EvaluationContext> lookahead_eval_contexts;
     int current_phase_start_g;
 
     // Statistics
@@ -53,6 +72,11 @@ class EnforcedHillClimbingSearch : public SearchAlgorithm {
     void expand(EvaluationContext &eval_context);
     void reach_state(
         const State &parent, OperatorID op_id, const State &state);
+    bool is_reached_in_current_phase(const EHCNodeInfo &info) const;
+    void start_phase(EvaluationContext &&eval_context, const SearchNode &node);
+    bool follow_preferred_operators();
+    EvaluationContext create_eval_context(
+        const State &state, const EHCNodeInfo &info);
     SearchStatus ehc();
 
 protected:
@@ -187,7 +187,8 @@ void IBEX::limitedDFS(State currState, int pathCost, int costLimit, int nodeLimi
 
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
-        State succ_state = currState.get_unregistered_successor(op);
+        State succ_state = currState.get_unregistered_successor(
+            op, state_registry.get_compiled_task());
         statistics.inc_generated();
 
         if (path_checking && pathContains(currentPath, succ_state))
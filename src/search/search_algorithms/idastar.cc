@@ -102,7 +102,8 @@ int IDAstar::search(State currState, int pathCost, int bound) {
     int next_bound = numeric_limits<int>::max();
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
-        State succ_state = currState.get_unregistered_successor(op);
+        State succ_state = currState.get_unregistered_successor(
+            op, state_registry.get_compiled_task());
         statistics.inc_generated();
         StateID succ_id = succ_state.get_id();
 
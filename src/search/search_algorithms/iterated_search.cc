@@ -66,6 +66,7 @@ SearchStatus IteratedSearch::step() {
     if (pass_bound) {
         current_search->set_bound(best_bound);
     }
+    current_search->set_solution_sharing(solution_sharing);
     ++phase;
 
     current_search->search();
@@ -78,7 +79,7 @@ SearchStatus IteratedSearch::step() {
         found_plan = current_search->get_plan();
         plan_cost = calculate_plan_cost(found_plan, task_proxy);
         if (plan_cost < best_bound) {
-            plan_manager.save_plan(found_plan, task_proxy, true);
+            save_intermediate_plan(found_plan);
             best_bound = plan_cost;
             set_plan(found_plan);
         }
@@ -163,7 +164,10 @@ public:
             "Note 1",
             "We don't cache heuristic values between search iterations at"
             " the moment. If you perform a LAMA-style iterative search,"
-            " heuristic values will be computed multiple times.");
+            " heuristic values will be computed multiple times. For"
+            " iterated weighted A* with a single heuristic, use"
+            " anytime_wastar, which keeps the search space and the"
+            " heuristic values between phases.");
         document_note(
             "Note 2",
             "The configuration\n```\n"
@@ -143,6 +143,7 @@ SearchStatus LazySearch::fetch_next_state() {
       and where to obtain it from.
     */
     current_eval_context = EvaluationContext(current_state, current_g, true, &statistics);
+    current_eval_context.set_parent_state_id(current_predecessor_id);
 
     return IN_PROGRESS;
 }
@@ -0,0 +1,185 @@
+#include "parallel_portfolio.h"
+
+#include "../plugins/plugin.h"
+#include "../utils/logging.h"
+#include "../utils/parallel.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+namespace parallel_portfolio {
+ParallelPortfolio::ParallelPortfolio(const plugins::Options &opts)
+    : SearchAlgorithm(opts),
+      algorithm_configs(opts.get_list<parser::LazyValue>("algorithm_configs")),
+      stop_on_first_solution(opts.get<bool>("stop_on_first_solution")),
+      best_bound(bound),
+      stop_flag(false),
+      num_plans(0) {
+}
+
+void ParallelPortfolio::construct_search_algorithms() {
+    /*
+      We construct all search algorithms (including their evaluators)
+      before starting any thread, so parse errors are reported here. Some
+      searches create further components or subtasks while they run (e.g.,
+      iterated search constructs its phases lazily), which is why the
+      PerTaskInformation objects are synchronized.
+    */
+    for (parser::LazyValue &algorithm_config : algorithm_configs) {
+        shared_ptr<SearchAlgorithm> search_algorithm;
+        try {
+            search_algorithm =
+                algorithm_config.construct<shared_ptr<SearchAlgorithm>>();
+        } catch (const utils::ContextError &e) {
+            cerr << "Delayed construction of LazyValue failed" << endl;
+            cerr << e.get_message() << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        search_algorithm->set_bound(min(search_algorithm->get_bound(), bound));
+        search_algorithm->set_solution_sharing(this);
+        search_algorithms.push_back(search_algorithm);
+    }
+}
+
+void ParallelPortfolio::report_plan(const Plan &plan) {
+    int plan_cost = calculate_plan_cost(plan, task_proxy);
+    lock_guard<mutex> lock(solution_mutex);
+    /*
+      With stop_on_first_solution, we only save the first plan, even if
+      another search finds a cheaper plan before it stops.
+    */
+    bool may_save = !stop_on_first_solution || !found_solution();
+    if (may_save && plan_cost < best_bound) {
+        plan_manager.save_plan(plan, task_proxy, !stop_on_first_solution);
+        ++num_plans;
+        best_bound = plan_cost;
+        set_plan(plan);
+    }
+    if (stop_on_first_solution) {
+        stop_flag = true;
+    }
+}
+
+int ParallelPortfolio::get_shared_bound() const {
+    return best_bound.load(memory_order_relaxed);
+}
+
+bool ParallelPortfolio::is_stop_requested() const {
+    return stop_flag.load(memory_order_relaxed);
+}
+
+SearchStatus ParallelPortfolio::step() {
+    construct_search_algorithms();
+    int num_searches = search_algorithms.size();
+    log << "Starting " << num_searches << " searches in parallel" << endl;
+
+    utils::run_in_parallel(
+        num_searches, [&](int i) {
+            try {
+                search_algorithms[i]->search();
+            } catch (...) {
+                // Let the other searches stop early.
+                stop_flag = true;
+                throw;
+            }
+        });
+
+    for (const shared_ptr<SearchAlgorithm> &search_algorithm : search_algorithms) {
+        log << "Statistics of search: "
+            << search_algorithm->get_description() << endl;
+        search_algorithm->print_statistics();
+
+        const SearchStatistics &current_stats = search_algorithm->get_statistics();
+        statistics.inc_expanded(current_stats.get_expanded());
+        statistics.inc_evaluated_states(current_stats.get_evaluated_states());
+        statistics.inc_evaluations(current_stats.get_evaluations());
+        statistics.inc_generated(current_stats.get_generated());
+        statistics.inc_generated_ops(current_stats.get_generated_ops());
+        statistics.inc_reopened(current_stats.get_reopened());
+    }
+    // Free the memory of the searches before the planner exits.
+    search_algorithms.clear();
+
+    if (found_solution()) {
+        log << "Best solution cost: " << best_bound << endl;
+        return SOLVED;
+    }
+    return FAILED;
+}
+
+void ParallelPortfolio::print_statistics() const {
+    log << "Cumulative statistics:" << endl;
+    statistics.print_detailed_statistics();
+    log << "Plans saved by portfolio: " << num_plans << endl;
+}
+
+void ParallelPortfolio::save_plan_if_necessary() {
+    // We don't need to save here, as we save each plan that improves on
+    // the best plan as soon as a search reports it.
+}
+
+class ParallelPortfolioFeature
+    : public plugins::TypedFeature<SearchAlgorithm, ParallelPortfolio> {
+public:
+    ParallelPortfolioFeature() : TypedFeature("parallel_portfolio") {
+        document_title("Parallel portfolio");
+        document_synopsis(
+            "Runs several search algorithms in parallel, each on its own "
+            "thread, on the same task. Whenever a search finds a plan that "
+            "is cheaper than all plans found before, the plan is saved and "
+            "its cost becomes the bound of all searches that are still "
+            "running. Searches report their plans as soon as they find them, "
+            "so the plans of anytime searches are shared while they run. "
+            "The wall-clock time of the portfolio is that of its "
+            "slowest search rather than the sum of all searches.");
+
+        add_list_option<shared_ptr<SearchAlgorithm>>(
+            "algorithm_configs",
+            "list of search algorithms that run in parallel",
+            "",
+            true);
+        add_option<bool>(
+            "stop_on_first_solution",
+            "stop all searches as soon as one of them finds a plan. This "
+            "suits satisficing portfolios. Otherwise, all searches run until "
+            "they finish, which suits optimal and anytime portfolios.",
+            "true");
+        SearchAlgorithm::add_options_to_feature(*this);
+
+        document_note(
+            "Shared components",
+            "The searches must not share components that have state, such "
+            "as predefined evaluators or random number generators with the "
+            "default random_seed=-1, since the searches access them "
+            "without synchronization. Define a separate evaluator for each "
+            "search and give each component its own random seed.");
+        document_note(
+            "Limits",
+            "Searches read the shared bound after each step, and the "
+            "searches only stop after their current step. Set max_time for "
+            "the individual searches to limit their running time. Memory is "
+            "shared by all searches.");
+        document_note(
+            "Output",
+            "Log output is written one message at a time, but the lines of "
+            "the searches may interleave.");
+    }
+
+    virtual shared_ptr<ParallelPortfolio> create_component(
+        const plugins::Options &options,
+        const utils::Context &context) const override {
+        plugins::Options options_copy(options);
+        // See IteratedSearchFeature for why we unpack the lazy list here.
+        vector<parser::LazyValue> algorithm_configs =
+            options.get<parser::LazyValue>("algorithm_configs").construct_lazy_list();
+        options_copy.set("algorithm_configs", algorithm_configs);
+        plugins::verify_list_non_empty<parser::LazyValue>(
+            context, options_copy, "algorithm_configs");
+        return make_shared<ParallelPortfolio>(options_copy);
+    }
+};
+
+static plugins::FeaturePlugin<ParallelPortfolioFeature> _plugin;
+}
@@ -0,0 +1,43 @@
+#ifndef SEARCH_ALGORITHMS_PARALLEL_PORTFOLIO_H
+#define SEARCH_ALGORITHMS_PARALLEL_PORTFOLIO_H
+
+#include "../search_algorithm.h"
+
+#include "../parser/decorated_abstract_syntax_tree.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace parallel_portfolio {
+class ParallelPortfolio : public SearchAlgorithm, public SolutionSharing {
+    std::vector<parser::LazyValue> algorithm_configs;
+    bool stop_on_first_solution;
+
+    std::vector<std::shared_ptr<SearchAlgorithm>> search_algorithms;
+
+    // Cost of the best plan found so far, shared with all searches.
+    std::atomic<int> best_bound;
+    std::atomic<bool> stop_flag;
+    // Guards saving plans and set_plan when searches report plans.
+    std::mutex solution_mutex;
+    int num_plans;
+
+    void construct_search_algorithms();
+
+    virtual SearchStatus step() override;
+
+public:
+    explicit ParallelPortfolio(const plugins::Options &opts);
+
+    virtual void report_plan(const Plan &plan) override;
+    virtual int get_shared_bound() const override;
+    virtual bool is_stop_requested() const override;
+
+    virtual void save_plan_if_necessary() override;
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
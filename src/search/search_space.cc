@@ -44,6 +44,10 @@ int SearchNode::get_real_g() const {
     return info.real_g;
 }
 
+StateID SearchNode::get_parent_state_id() const {
+    return info.parent_state_id;
+}
+
 void SearchNode::open_initial() {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
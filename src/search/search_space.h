@@ -30,6 +30,7 @@ public:
 
     int get_g() const;
     int get_real_g() const;
+    StateID get_parent_state_id() const;
 
     void open_initial();
     void open(const SearchNode &parent_node,
@@ -3,20 +3,57 @@
 #include "per_state_information.h"
 #include "task_proxy.h"
 
+#include "task_utils/compiled_task.h"
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
 
+#include <algorithm>
+
 using namespace std;
 
 StateRegistry::StateRegistry(const TaskProxy &task_proxy)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
+      compiled_task(compiled_task::g_compiled_tasks[task_proxy]),
       num_variables(task_proxy.get_variables().size()),
       state_data_pool(get_bins_per_state()),
       registered_states(
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state())) {
+    if (task_properties::has_axioms(task_proxy)) {
+        successor_mode = SuccessorMode::AXIOMS;
+    } else if (compiled_task.has_conditional_effects()) {
+        successor_mode = SuccessorMode::CONDITIONAL_EFFECTS;
+    } else {
+        successor_mode = SuccessorMode::UNCONDITIONAL_EFFECTS;
+        compute_bin_writes();
+    }
+}
+
+void StateRegistry::compute_bin_writes() {
+    int num_operators = compiled_task.get_num_operators();
+    bin_write_offsets.reserve(num_operators + 1);
+    bin_write_offsets.push_back(0);
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        int begin = bin_writes.size();
+        for (const FactPair &effect : compiled_task.get_effects(op_id)) {
+            int_packer::IntPacker::BinWrite write =
+                state_packer.get_bin_write(effect.var, effect.value);
+            auto it = find_if(
+                bin_writes.begin() + begin, bin_writes.end(),
+                [&](const int_packer::IntPacker::BinWrite &other) {
+                    return other.bin_index == write.bin_index;
+                });
+            if (it == bin_writes.end()) {
+                bin_writes.push_back(write);
+            } else {
+                it->add(write);
+            }
+        }
+        bin_write_offsets.push_back(bin_writes.size());
+    }
+    bin_writes.shrink_to_fit();
 }
 
 StateID StateRegistry::insert_id_or_pop_state() {
@@ -32,7 +69,7 @@ StateID StateRegistry::insert_id_or_pop_state() {
     if (!is_new_entry) {
         state_data_pool.pop_back();
     }
-    assert(registered_states.size() == static_cast<int>(state_data_pool.size()));
+    assert(static_cast<size_t>(registered_states.size()) == state_data_pool.size());
     return StateID(result.first);
 }
 
@@ -66,33 +103,58 @@ State StateRegistry::get_successor_state(const State &predecessor, const Operato
     assert(!op.is_axiom());
     state_data_pool.push_back(predecessor.get_buffer());
     PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
-    /* Experiments for issue348 showed that for tasks with axioms it's faster
-       to compute successor states using unpacked data. */
-    if (task_properties::has_axioms(task_proxy)) {
+    switch (successor_mode) {
+    case SuccessorMode::UNCONDITIONAL_EFFECTS:
+    {
+        int end = bin_write_offsets[op.get_id() + 1];
+        for (int i = bin_write_offsets[op.get_id()]; i < end; ++i) {
+            bin_writes[i].apply(buffer);
+        }
+        break;
+    }
+    case SuccessorMode::CONDITIONAL_EFFECTS:
+        compiled_task.for_each_firing_effect(
+            op.get_id(), predecessor, [&](const FactPair &effect) {
+                state_packer.set(buffer, effect.var, effect.value);
+            });
+        break;
+    case SuccessorMode::AXIOMS:
+    {
+        /* Experiments for issue348 showed that for tasks with axioms it's
+           faster to compute successor states using unpacked data. */
         predecessor.unpack();
         vector<int> new_values = predecessor.get_unpacked_values();
-        for (EffectProxy effect : op.get_effects()) {
-            if (does_fire(effect, predecessor)) {
-                FactPair effect_pair = effect.get_fact().get_pair();
-                new_values[effect_pair.var] = effect_pair.value;
-            }
-        }
-        axiom_evaluator.evaluate(new_values);
+        changed_vars.clear();
+        compiled_task.for_each_firing_effect(
+            op.get_id(), predecessor, [&](const FactPair &effect) {
+                if (new_values[effect.var] != effect.value) {
+                    new_values[effect.var] = effect.value;
+                    changed_vars.push_back(effect.var);
+                }
+            });
+        axiom_evaluator.evaluate_incrementally(new_values, changed_vars);
         for (size_t i = 0; i < new_values.size(); ++i) {
             state_packer.set(buffer, i, new_values[i]);
         }
         StateID id = insert_id_or_pop_state();
         return task_proxy.create_state(*this, id, buffer, move(new_values));
-    } else {
-        for (EffectProxy effect : op.get_effects()) {
-            if (does_fire(effect, predecessor)) {
-                FactPair effect_pair = effect.get_fact().get_pair();
-                state_packer.set(buffer, effect_pair.var, effect_pair.value);
-            }
-        }
-        StateID id = insert_id_or_pop_state();
-        return task_proxy.create_state(*this, id, buffer);
     }
+    }
+    StateID id = insert_id_or_pop_state();
+    return task_proxy.create_state(*this, id, buffer);
+}
+
+State StateRegistry::register_state(vector<int> &&values) {
+    assert(static_cast<int>(values.size()) == num_variables);
+    // Avoid garbage values in half-full bins.
+    vector<PackedStateBin> buffer(get_bins_per_state(), 0);
+    for (int var = 0; var < num_variables; ++var) {
+        state_packer.set(buffer.data(), var, values[var]);
+    }
+    state_data_pool.push_back(buffer.data());
+    StateID id = insert_id_or_pop_state();
+    return task_proxy.create_state(
+        *this, id, state_data_pool[id.value], move(values));
 }
 
 int StateRegistry::get_bins_per_state() const {
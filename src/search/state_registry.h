@@ -9,6 +9,7 @@
 #include "algorithms/int_packer.h"
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
+#include "algorithms/wide_int_hash_set.h"
 #include "utils/hash.h"
 
 #include <set>
@@ -38,7 +39,7 @@
     is why IDs are intended for long term storage (e.g. in open lists).
     Internally, a StateID is just an integer, so it is cheap to store and copy.
 
-  PackedStateBin (currently the same as unsigned int)
+  PackedStateBin (unsigned int, or uint64_t with USE_64_BIT_STATE_BINS)
     The actual state data is internally represented as a PackedStateBin array.
     Each PackedStateBin can contain the values of multiple variables.
     To minimize allocation overhead, the implementation stores the data of many
@@ -105,6 +106,10 @@
     The heuristic object uses an attribute of type PerStateBitset to store for each
     state and each landmark whether it was reached in this state.
 */
+namespace compiled_task {
+class CompiledTask;
+}
+
 namespace int_packer {
 class IntPacker;
 }
@@ -113,6 +118,27 @@ using PackedStateBin = int_packer::IntPacker::Bin;
 
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+    /*
+      Most tasks fit into a few bins per state. For these sizes, we hash and
+      compare states with loops whose length is known at compile time, so
+      that the compiler can unroll them.
+    */
+    template<int NUM_BINS>
+    static void feed_bins(utils::HashState &hash_state, const PackedStateBin *data) {
+        for (int i = 0; i < NUM_BINS; ++i) {
+            utils::feed(hash_state, data[i]);
+        }
+    }
+
+    template<int NUM_BINS>
+    static bool bins_equal(const PackedStateBin *lhs_data, const PackedStateBin *rhs_data) {
+        for (int i = 0; i < NUM_BINS; ++i) {
+            if (lhs_data[i] != rhs_data[i])
+                return false;
+        }
+        return true;
+    }
+
     struct StateIDSemanticHash {
         const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
         int state_size;
@@ -123,13 +149,36 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
               state_size(state_size) {
         }
 
+#ifdef USE_WIDE_STATE_ID_SET
+        std::uint64_t operator()(int id) const {
+#else
         int_hash_set::HashType operator()(int id) const {
+#endif
             const PackedStateBin *data = state_data_pool[id];
             utils::HashState hash_state;
-            for (int i = 0; i < state_size; ++i) {
-                hash_state.feed(data[i]);
+            switch (state_size) {
+            case 1:
+                feed_bins<1>(hash_state, data);
+                break;
+            case 2:
+                feed_bins<2>(hash_state, data);
+                break;
+            case 3:
+                feed_bins<3>(hash_state, data);
+                break;
+            case 4:
+                feed_bins<4>(hash_state, data);
+                break;
+            default:
+                for (int i = 0; i < state_size; ++i) {
+                    utils::feed(hash_state, data[i]);
+                }
             }
+#ifdef USE_WIDE_STATE_ID_SET
+            return hash_state.get_hash64();
+#else
             return hash_state.get_hash32();
+#endif
         }
     };
 
@@ -146,7 +195,18 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
         bool operator()(int lhs, int rhs) const {
             const PackedStateBin *lhs_data = state_data_pool[lhs];
             const PackedStateBin *rhs_data = state_data_pool[rhs];
-            return std::equal(lhs_data, lhs_data + state_size, rhs_data);
+            switch (state_size) {
+            case 1:
+                return bins_equal<1>(lhs_data, rhs_data);
+            case 2:
+                return bins_equal<2>(lhs_data, rhs_data);
+            case 3:
+                return bins_equal<3>(lhs_data, rhs_data);
+            case 4:
+                return bins_equal<4>(lhs_data, rhs_data);
+            default:
+                return std::equal(lhs_data, lhs_data + state_size, rhs_data);
+            }
         }
     };
 
@@ -154,19 +214,58 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
       Hash set of StateIDs used to detect states that are already registered in
       this registry and find their IDs. States are compared/hashed semantically,
       i.e. the actual state data is compared, not the memory location.
+
+      With USE_WIDE_STATE_ID_SET, we use a hash set with 64-bit hashes
+      whose capacity is not limited to 2^30 buckets and that grows
+      incrementally instead of rehashing all states at once. Only the
+      layout of the set changes: StateIDs are still ints, so we store them
+      as 32-bit keys and a registry still holds at most 2^31 - 1 states.
     */
+#ifdef USE_WIDE_STATE_ID_SET
+    using StateIDSet = wide_int_hash_set::WideIntHashSet<
+        StateIDSemanticHash, StateIDSemanticEqual, int>;
+#else
     using StateIDSet = int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
+#endif
+
+    /*
+      Successor states are computed in one of the following ways, chosen
+      when the registry is created, so that the common case of tasks without
+      axioms and conditional effects does not pay for the general one.
+    */
+    enum class SuccessorMode {
+        // Apply precomputed bin writes of the operator to the packed state.
+        UNCONDITIONAL_EFFECTS,
+        // Set the effects whose conditions hold in the packed state.
+        CONDITIONAL_EFFECTS,
+        // Apply the effects to the unpacked state and evaluate the axioms.
+        AXIOMS
+    };
 
     TaskProxy task_proxy;
     const int_packer::IntPacker &state_packer;
     AxiomEvaluator &axiom_evaluator;
+    const compiled_task::CompiledTask &compiled_task;
     const int num_variables;
+    SuccessorMode successor_mode;
+
+    /*
+      For SuccessorMode::UNCONDITIONAL_EFFECTS, the effects of operator op
+      are stored as the writes bin_writes[bin_write_offsets[op]], ...,
+      bin_writes[bin_write_offsets[op + 1] - 1], with one write per bin.
+    */
+    std::vector<int> bin_write_offsets;
+    std::vector<int_packer::IntPacker::BinWrite> bin_writes;
+
+    // Variables changed by the last operator for SuccessorMode::AXIOMS.
+    std::vector<int> changed_vars;
 
     segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
     StateIDSet registered_states;
 
     std::unique_ptr<State> cached_initial_state;
 
+    void compute_bin_writes();
     StateID insert_id_or_pop_state();
     int get_bins_per_state() const;
 public:
@@ -184,6 +283,10 @@ public:
         return state_packer;
     }
 
+    const compiled_task::CompiledTask &get_compiled_task() const {
+        return compiled_task;
+    }
+
     /*
       Returns the state that was registered at the given ID. The ID must refer
       to a state in this registry. Do not mix IDs from from different registries.
@@ -203,6 +306,13 @@ public:
     */
     State get_successor_state(const State &predecessor, const OperatorProxy &op);
 
+    /*
+      Returns the state with the given values and registers it if this was
+      not done before. The values must be consistent with the axioms of the
+      task. Like get_successor_state, this includes duplicate checking.
+    */
+    State register_state(std::vector<int> &&values);
+
     /*
       Returns the number of states registered so far.
     */
@@ -0,0 +1,118 @@
+#include "state_value_cache.h"
+
+#include "task_proxy.h"
+
+#include "task_utils/task_properties.h"
+#include "utils/hash.h"
+#include "utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+StateValueCache::StateValueCache(size_t memory_limit_in_bytes)
+    : memory_limit_in_bytes(memory_limit_in_bytes),
+      packer(nullptr),
+      num_bins(0),
+      num_sets(0),
+      buffer_set(0),
+      num_lookups(0),
+      num_hits(0),
+      num_evictions(0) {
+}
+
+void StateValueCache::initialize(const State &state) {
+    assert(!packer);
+    packer = &task_properties::g_state_packers[state.get_task()];
+    num_bins = packer->get_num_bins();
+    size_t bytes_per_slot = num_bins * sizeof(Bin) + sizeof(int) + sizeof(uint8_t);
+    size_t num_slots = memory_limit_in_bytes / bytes_per_slot;
+    // Use a power of two for the number of sets to map hashes cheaply.
+    num_sets = 1;
+    while (2 * num_sets * SLOTS_PER_SET <= num_slots) {
+        num_sets *= 2;
+    }
+    num_slots = num_sets * SLOTS_PER_SET;
+    keys.resize(num_slots * num_bins);
+    values.resize(num_slots);
+    flags.resize(num_slots, 0);
+    clock_hands.resize(num_sets, 0);
+    buffer.resize(num_bins);
+}
+
+void StateValueCache::pack_into_buffer(const State &state) {
+    if (!packer) {
+        initialize(state);
+    }
+    if (state.get_registry()) {
+        const Bin *packed = state.get_buffer();
+        copy(packed, packed + num_bins, buffer.begin());
+    } else {
+        state.unpack();
+        const vector<int> &state_values = state.get_unpacked_values();
+        int num_vars = state_values.size();
+        for (int var = 0; var < num_vars; ++var) {
+            packer->set(buffer.data(), var, state_values[var]);
+        }
+    }
+    utils::HashState hash_state;
+    for (Bin bin : buffer) {
+        utils::feed(hash_state, bin);
+    }
+    buffer_set = hash_state.get_hash64() & (num_sets - 1);
+}
+
+bool StateValueCache::key_matches_buffer(size_t slot) const {
+    return equal(buffer.begin(), buffer.end(), keys.begin() + slot * num_bins);
+}
+
+bool StateValueCache::lookup(const State &state, int &value) {
+    ++num_lookups;
+    pack_into_buffer(state);
+    size_t first_slot = buffer_set * SLOTS_PER_SET;
+    for (size_t slot = first_slot; slot < first_slot + SLOTS_PER_SET; ++slot) {
+        if ((flags[slot] & OCCUPIED) && key_matches_buffer(slot)) {
+            flags[slot] |= REFERENCED;
+            value = values[slot];
+            ++num_hits;
+            return true;
+        }
+    }
+    return false;
+}
+
+void StateValueCache::insert(const State &state, int value) {
+    pack_into_buffer(state);
+    size_t first_slot = buffer_set * SLOTS_PER_SET;
+    size_t slot = first_slot;
+    while (slot < first_slot + SLOTS_PER_SET) {
+        if (!(flags[slot] & OCCUPIED) || key_matches_buffer(slot)) {
+            break;
+        }
+        ++slot;
+    }
+    if (slot == first_slot + SLOTS_PER_SET) {
+        /* All slots are occupied by other states: advance the clock hand,
+           giving referenced entries a second chance, until we find an
+           unreferenced entry to evict. */
+        uint8_t &hand = clock_hands[buffer_set];
+        while (flags[first_slot + hand] & REFERENCED) {
+            flags[first_slot + hand] &= ~REFERENCED;
+            hand = (hand + 1) % SLOTS_PER_SET;
+        }
+        slot = first_slot + hand;
+        hand = (hand + 1) % SLOTS_PER_SET;
+        ++num_evictions;
+    }
+    copy(buffer.begin(), buffer.end(), keys.begin() + slot * num_bins);
+    values[slot] = value;
+    flags[slot] = OCCUPIED;
+}
+
+void StateValueCache::print_statistics(utils::LogProxy &log) const {
+    double hit_rate = num_lookups ? static_cast<double>(num_hits) / num_lookups : 0;
+    log << num_lookups << " lookups, " << num_hits << " hits (hit rate "
+        << hit_rate * 100 << "%), " << num_evictions << " evictions, "
+        << num_sets * SLOTS_PER_SET << " slots" << endl;
+}
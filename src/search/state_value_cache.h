@@ -0,0 +1,72 @@
+#ifndef STATE_VALUE_CACHE_H
+#define STATE_VALUE_CACHE_H
+
+#include "algorithms/int_packer.h"
+
+#include <cstdint>
+#include <vector>
+
+class State;
+
+namespace utils {
+class LogProxy;
+}
+
+/*
+  Bounded cache that maps states to integer values (e.g., heuristic
+  values). Unlike PerStateInformation, it does not require registered
+  states, so it can also be used by searches that work on unregistered
+  states such as IDA*.
+
+  Keys are the packed representations of the states, so lookups are exact.
+  The cache is split into many small sets of slots. The hash of the packed
+  state determines the set, and each set replaces its entries with the
+  CLOCK algorithm (an approximation of least-recently-used replacement).
+  The total number of slots is derived from the given memory limit when
+  the first state is inserted.
+*/
+class StateValueCache {
+    using Bin = int_packer::IntPacker::Bin;
+
+    static const int SLOTS_PER_SET = 8;
+    static const std::uint8_t OCCUPIED = 1;
+    static const std::uint8_t REFERENCED = 2;
+
+    const std::size_t memory_limit_in_bytes;
+
+    // Initialized lazily since we only know the task with the first state.
+    const int_packer::IntPacker *packer;
+    int num_bins;
+    std::size_t num_sets;
+
+    std::vector<Bin> keys;
+    std::vector<int> values;
+    std::vector<std::uint8_t> flags;
+    std::vector<std::uint8_t> clock_hands;
+
+    // Packed version of the state passed to the last lookup or insert call.
+    std::vector<Bin> buffer;
+    std::size_t buffer_set;
+
+    std::uint64_t num_lookups;
+    std::uint64_t num_hits;
+    std::uint64_t num_evictions;
+
+    void initialize(const State &state);
+    void pack_into_buffer(const State &state);
+    bool key_matches_buffer(std::size_t slot) const;
+
+public:
+    explicit StateValueCache(std::size_t memory_limit_in_bytes);
+
+    /*
+      Return true and store the cached value for the state in value if the
+      state is cached. Otherwise, return false and leave value unchanged.
+    */
+    bool lookup(const State &state, int &value);
+    void insert(const State &state, int value);
+
+    void print_statistics(utils::LogProxy &log) const;
+};
+
+#endif
@@ -0,0 +1,328 @@
+#include "structural_symmetries.h"
+
+#include "../state_registry.h"
+#include "../task_proxy.h"
+
+#include "../algorithms/graph_automorphisms.h"
+#include "../plugins/plugin.h"
+#include "../task_utils/compiled_task.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/logging.h"
+#include "../utils/markup.h"
+#include "../utils/system.h"
+#include "../utils/timer.h"
+
+#include <cassert>
+#include <map>
+#include <numeric>
+
+using namespace std;
+
+namespace structural_symmetries {
+// Vertex colors of the problem description graph.
+enum Color {
+    FACT,
+    GOAL_FACT,
+    VARIABLE,
+    PRECONDITIONS,
+    EFFECTS,
+    // Operators with different costs get different colors starting here.
+    OPERATOR
+};
+
+StructuralSymmetries::StructuralSymmetries(const plugins::Options &opts)
+    : max_time(opts.get<double>("max_time")),
+      log(utils::get_log_from_options(opts)) {
+}
+
+void StructuralSymmetries::initialize(const shared_ptr<AbstractTask> &task_) {
+    if (task == task_) {
+        return;
+    }
+    task = task_;
+    TaskProxy task_proxy(*task);
+    task_properties::verify_no_axioms(task_proxy);
+    task_properties::verify_no_conditional_effects(task_proxy);
+
+    fact_offsets.clear();
+    var_of_fact.clear();
+    value_of_fact.clear();
+    for (VariableProxy var : task_proxy.get_variables()) {
+        fact_offsets.push_back(var_of_fact.size());
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            var_of_fact.push_back(var.get_id());
+            value_of_fact.push_back(value);
+        }
+    }
+
+    utils::Timer timer;
+    compute_generators(task_proxy);
+    if (log.is_at_least_normal()) {
+        log << "Number of symmetry generators: " << generators.size() << endl;
+        log << "Time for computing symmetries: " << timer << endl;
+    }
+}
+
+void StructuralSymmetries::compute_generators(const TaskProxy &task_proxy) {
+    /*
+      The problem description graph has a vertex for each fact and variable,
+      and three vertices for each operator: the operator itself and two
+      auxiliary vertices connecting it to its preconditions and effects. Fact
+      vertices come first, so automorphisms map fact i to fact perm[i].
+    */
+    VariablesProxy variables = task_proxy.get_variables();
+    OperatorsProxy operators = task_proxy.get_operators();
+    int num_facts = var_of_fact.size();
+    int num_vertices = num_facts + variables.size() + 3 * operators.size();
+    vector<vector<int>> graph(num_vertices);
+    vector<int> colors(num_vertices, FACT);
+    auto add_edge = [&](int v1, int v2) {
+            graph[v1].push_back(v2);
+            graph[v2].push_back(v1);
+        };
+
+    for (FactProxy goal : task_proxy.get_goals()) {
+        FactPair fact = goal.get_pair();
+        colors[fact_offsets[fact.var] + fact.value] = GOAL_FACT;
+    }
+
+    int vertex = num_facts;
+    for (VariableProxy var : variables) {
+        colors[vertex] = VARIABLE;
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            add_edge(vertex, fact_offsets[var.get_id()] + value);
+        }
+        ++vertex;
+    }
+
+    map<int, int> cost_colors;
+    for (OperatorProxy op : operators) {
+        cost_colors.emplace(op.get_cost(), 0);
+    }
+    int next_color = OPERATOR;
+    for (auto &entry : cost_colors) {
+        entry.second = next_color++;
+    }
+
+    for (OperatorProxy op : operators) {
+        int op_vertex = vertex++;
+        int pre_vertex = vertex++;
+        int eff_vertex = vertex++;
+        colors[op_vertex] = cost_colors[op.get_cost()];
+        colors[pre_vertex] = PRECONDITIONS;
+        colors[eff_vertex] = EFFECTS;
+        add_edge(op_vertex, pre_vertex);
+        add_edge(op_vertex, eff_vertex);
+        for (FactProxy pre : op.get_preconditions()) {
+            FactPair fact = pre.get_pair();
+            add_edge(pre_vertex, fact_offsets[fact.var] + fact.value);
+        }
+        for (EffectProxy eff : op.get_effects()) {
+            FactPair fact = eff.get_fact().get_pair();
+            add_edge(eff_vertex, fact_offsets[fact.var] + fact.value);
+        }
+    }
+    assert(vertex == num_vertices);
+
+    vector<vector<int>> automorphisms =
+        graph_automorphisms::compute_automorphism_generators(
+            graph, colors, max_time);
+
+    generators.clear();
+    inverse_generators.clear();
+    for (const vector<int> &automorphism : automorphisms) {
+        vector<int> permutation(automorphism.begin(),
+                                automorphism.begin() + num_facts);
+        // Automorphisms that only permute operators do not affect states.
+        bool is_identity = true;
+        for (int fact = 0; fact < num_facts; ++fact) {
+            if (permutation[fact] != fact) {
+                is_identity = false;
+                break;
+            }
+        }
+        if (is_identity)
+            continue;
+        vector<int> inverse(num_facts);
+        for (int fact = 0; fact < num_facts; ++fact) {
+            inverse[permutation[fact]] = fact;
+        }
+        generators.push_back(move(permutation));
+        inverse_generators.push_back(move(inverse));
+    }
+}
+
+void StructuralSymmetries::apply_permutation(
+    const vector<int> &permutation, const vector<int> &values,
+    vector<int> &result) const {
+    result.resize(values.size());
+    for (size_t var = 0; var < values.size(); ++var) {
+        int image = permutation[fact_offsets[var] + values[var]];
+        result[var_of_fact[image]] = value_of_fact[image];
+    }
+}
+
+void StructuralSymmetries::compute_canonical_values(
+    vector<int> &values, vector<int> *applied_generators) const {
+    vector<int> permuted_values;
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        for (size_t i = 0; i < generators.size(); ++i) {
+            apply_permutation(generators[i], values, permuted_values);
+            if (permuted_values < values) {
+                values.swap(permuted_values);
+                improved = true;
+                if (applied_generators) {
+                    applied_generators->push_back(i);
+                }
+            }
+        }
+    }
+}
+
+State StructuralSymmetries::get_canonical_successor_state(
+    StateRegistry &registry, const State &state, const OperatorProxy &op) const {
+    assert(task_properties::is_applicable(op, state));
+    state.unpack();
+    vector<int> values = state.get_unpacked_values();
+    for (EffectProxy effect : op.get_effects()) {
+        FactPair fact = effect.get_fact().get_pair();
+        values[fact.var] = fact.value;
+    }
+    compute_canonical_values(values);
+    return registry.register_state(move(values));
+}
+
+Plan StructuralSymmetries::compute_unpermuted_plan(const Plan &plan) const {
+    TaskProxy task_proxy(*task);
+    OperatorsProxy operators = task_proxy.get_operators();
+
+    /*
+      The plan leads through canonical states c_0, ..., c_n. We keep track
+      of a permutation that maps c_i to the actual state s_i reached by the
+      unpermuted plan. If c_{i+1} is the result of applying the generators
+      g_1, ..., g_k to the successor of c_i, then the successor of s_i is
+      mapped to s_{i+1} by the permutation composed with the inverses of
+      g_1, ..., g_k.
+    */
+    int num_facts = var_of_fact.size();
+    vector<int> permutation(num_facts);
+    iota(permutation.begin(), permutation.end(), 0);
+    vector<int> composed_permutation(num_facts);
+
+    const compiled_task::CompiledTask &compiled_task =
+        compiled_task::g_compiled_tasks[task_proxy];
+    State canonical_state = task_proxy.get_initial_state();
+    State state = task_proxy.get_initial_state();
+    vector<int> applied_generators;
+    Plan unpermuted_plan;
+    for (OperatorID op_id : plan) {
+        OperatorProxy op = operators[op_id];
+        State canonical_succ = canonical_state.get_unregistered_successor(
+            op, compiled_task);
+        vector<int> succ_values;
+        apply_permutation(permutation, canonical_succ.get_unpacked_values(),
+                          succ_values);
+
+        OperatorID unpermuted_op_id = OperatorID::no_operator;
+        for (OperatorProxy candidate : operators) {
+            if (candidate.get_cost() == op.get_cost() &&
+                task_properties::is_applicable(candidate, state) &&
+                state.get_unregistered_successor(
+                    candidate, compiled_task).get_unpacked_values() ==
+                succ_values) {
+                unpermuted_op_id = OperatorID(candidate.get_id());
+                break;
+            }
+        }
+        if (unpermuted_op_id == OperatorID::no_operator) {
+            ABORT("Could not map plan found by orbit search to the task.");
+        }
+        unpermuted_plan.push_back(unpermuted_op_id);
+
+        vector<int> canonical_values = canonical_succ.get_unpacked_values();
+        applied_generators.clear();
+        compute_canonical_values(canonical_values, &applied_generators);
+        for (int generator : applied_generators) {
+            const vector<int> &inverse = inverse_generators[generator];
+            for (int fact = 0; fact < num_facts; ++fact) {
+                composed_permutation[fact] = permutation[inverse[fact]];
+            }
+            permutation.swap(composed_permutation);
+        }
+        canonical_state = task_proxy.create_state(move(canonical_values));
+        state = task_proxy.create_state(move(succ_values));
+    }
+    return unpermuted_plan;
+}
+
+void add_symmetries_option_to_feature(plugins::Feature &feature) {
+    feature.add_option<shared_ptr<StructuralSymmetries>>(
+        "symmetries",
+        "structural symmetries used for orbit search: only canonical "
+        "representatives of successor states are registered, so symmetric "
+        "states are treated as duplicates. Not supported for tasks with "
+        "axioms or conditional effects and for path-dependent evaluators.",
+        plugins::ArgumentInfo::NO_DEFAULT);
+}
+
+class StructuralSymmetriesFeature
+    : public plugins::TypedFeature<StructuralSymmetries, StructuralSymmetries> {
+public:
+    StructuralSymmetriesFeature() : TypedFeature("structural_symmetries") {
+        document_title("Structural symmetries");
+        document_synopsis(
+            "Symmetries of the planning task, computed as automorphisms of "
+            "its problem description graph with a bundled graph automorphism "
+            "search. For details, see"
+            + utils::format_conference_reference(
+                {"Nir Pochter", "Aviv Zohar", "Jeffrey S. Rosenschein"},
+                "Exploiting Problem Symmetries in State-Based Planners",
+                "https://www.aaai.org/ocs/index.php/AAAI/AAAI11/paper/view/3732",
+                "Proceedings of the Twenty-Fifth AAAI Conference on Artificial "
+                "Intelligence (AAAI 2011)",
+                "1004-1009",
+                "AAAI Press",
+                "2011")
+            + "and"
+            + utils::format_conference_reference(
+                {"Carmel Domshlak", "Michael Katz", "Alexander Shleyfman"},
+                "Enhanced Symmetry Breaking in Cost-Optimal Planning as "
+                "Forward Search",
+                "https://www.aaai.org/ocs/index.php/ICAPS/ICAPS12/paper/view/4698",
+                "Proceedings of the Twenty-Second International Conference on "
+                "Automated Planning and Scheduling (ICAPS 2012)",
+                "343-347",
+                "AAAI Press",
+                "2012"));
+
+        add_option<double>(
+            "max_time",
+            "maximum time in seconds for computing symmetries. If the limit "
+            "is reached, the symmetries found so far are used.",
+            "infinity",
+            plugins::Bounds("0.0", "infinity"));
+        utils::add_log_options_to_feature(*this);
+
+        document_note(
+            "Example",
+            "Orbit search with A* and blind search:\n"
+            "```\n--search astar(blind(), symmetries=structural_symmetries())\n```");
+    }
+};
+
+static plugins::FeaturePlugin<StructuralSymmetriesFeature> _plugin;
+
+static class StructuralSymmetriesCategoryPlugin
+    : public plugins::TypedCategoryPlugin<StructuralSymmetries> {
+public:
+    StructuralSymmetriesCategoryPlugin() : TypedCategoryPlugin("StructuralSymmetries") {
+        document_synopsis(
+            "Structural symmetries of the planning task, which search "
+            "algorithms can use to prune symmetric states.");
+        allow_variable_binding();
+    }
+}
+_category_plugin;
+}
@@ -0,0 +1,96 @@
+#ifndef STRUCTURAL_SYMMETRIES_STRUCTURAL_SYMMETRIES_H
+#define STRUCTURAL_SYMMETRIES_STRUCTURAL_SYMMETRIES_H
+
+#include "../plan_manager.h"
+
+#include "../utils/logging.h"
+
+#include <memory>
+#include <vector>
+
+class AbstractTask;
+class OperatorProxy;
+class State;
+class StateRegistry;
+class TaskProxy;
+
+namespace plugins {
+class Feature;
+class Options;
+}
+
+namespace structural_symmetries {
+/*
+  Structural symmetries of a planning task, computed as automorphisms of its
+  problem description graph (Pochter et al., AAAI 2011; Shleyfman et al.,
+  AAAI 2015). Each generator is stored as a permutation of the facts of the
+  task, which maps states to symmetric states.
+
+  Search algorithms use the symmetries for orbit search (Domshlak et al.,
+  ICAPS 2012): instead of registering a successor state, they register its
+  canonical representative, so symmetric states are treated as duplicates.
+  The resulting plans consist of operators applied to canonical states and
+  have to be mapped back to operators applicable in the actual states with
+  compute_unpermuted_plan.
+
+  We compute canonical representatives greedily by applying generators as
+  long as this leads to lexicographically smaller states. Therefore, two
+  symmetric states are not guaranteed to have the same representative, but
+  each representative is symmetric to the original state.
+*/
+class StructuralSymmetries {
+    const double max_time;
+    mutable utils::LogProxy log;
+
+    std::shared_ptr<AbstractTask> task;
+    std::vector<int> fact_offsets;
+    std::vector<int> var_of_fact;
+    std::vector<int> value_of_fact;
+    std::vector<std::vector<int>> generators;
+    std::vector<std::vector<int>> inverse_generators;
+
+    void compute_generators(const TaskProxy &task_proxy);
+    void apply_permutation(const std::vector<int> &permutation,
+                           const std::vector<int> &values,
+                           std::vector<int> &result) const;
+public:
+    explicit StructuralSymmetries(const plugins::Options &opts);
+
+    /*
+      Compute the symmetries of the given task. Calling this again for the
+      same task has no effect, so the object can be shared between several
+      search algorithms.
+    */
+    void initialize(const std::shared_ptr<AbstractTask> &task);
+
+    int get_num_generators() const {
+        return generators.size();
+    }
+
+    /*
+      Replace values by their canonical representative. If applied_generators
+      is given, the indices of the generators that were applied are appended
+      to it in order of application.
+    */
+    void compute_canonical_values(
+        std::vector<int> &values,
+        std::vector<int> *applied_generators = nullptr) const;
+
+    /*
+      Return the canonical representative of the successor of state under op
+      and register it in registry.
+    */
+    State get_canonical_successor_state(
+        StateRegistry &registry, const State &state, const OperatorProxy &op) const;
+
+    /*
+      Map a plan found by orbit search, starting in the initial state of the
+      task, to a plan for the task with the same cost.
+    */
+    Plan compute_unpermuted_plan(const Plan &plan) const;
+};
+
+extern void add_symmetries_option_to_feature(plugins::Feature &feature);
+}
+
+#endif
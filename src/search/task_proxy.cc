@@ -4,6 +4,7 @@
 #include "state_registry.h"
 
 #include "task_utils/causal_graph.h"
+#include "task_utils/compiled_task.h"
 #include "task_utils/task_properties.h"
 
 #include <iostream>
@@ -35,23 +36,58 @@ State::State(const AbstractTask &task, vector<int> &&values)
     assert(num_variables == task.get_num_variables());
 }
 
+/*
+  Apply the effects that for_each_firing_effect passes to its callback to
+  values and evaluate the axioms of the task.
+*/
+template<typename ForEachFiringEffect>
+static void apply_effects_and_axioms(
+    const AbstractTask &task, vector<int> &values,
+    const ForEachFiringEffect &for_each_firing_effect) {
+    if (task.get_num_axioms() > 0) {
+        vector<int> changed_vars;
+        for_each_firing_effect([&](const FactPair &effect) {
+                if (values[effect.var] != effect.value) {
+                    values[effect.var] = effect.value;
+                    changed_vars.push_back(effect.var);
+                }
+            });
+        AxiomEvaluator &axiom_evaluator = g_axiom_evaluators[TaskProxy(task)];
+        axiom_evaluator.evaluate_incrementally(values, changed_vars);
+    } else {
+        for_each_firing_effect([&](const FactPair &effect) {
+                values[effect.var] = effect.value;
+            });
+    }
+}
+
 State State::get_unregistered_successor(const OperatorProxy &op) const {
     assert(!op.is_axiom());
     assert(task_properties::is_applicable(op, *this));
     assert(values);
     vector<int> new_values = get_unpacked_values();
+    apply_effects_and_axioms(
+        *task, new_values, [&](const auto &callback) {
+            for (EffectProxy effect : op.get_effects()) {
+                if (does_fire(effect, *this)) {
+                    callback(effect.get_fact().get_pair());
+                }
+            }
+        });
+    return State(*task, move(new_values));
+}
 
-    for (EffectProxy effect : op.get_effects()) {
-        if (does_fire(effect, *this)) {
-            FactPair effect_fact = effect.get_fact().get_pair();
-            new_values[effect_fact.var] = effect_fact.value;
-        }
-    }
-
-    if (task->get_num_axioms() > 0) {
-        AxiomEvaluator &axiom_evaluator = g_axiom_evaluators[TaskProxy(*task)];
-        axiom_evaluator.evaluate(new_values);
-    }
+State State::get_unregistered_successor(
+    const OperatorProxy &op,
+    const compiled_task::CompiledTask &compiled_task) const {
+    assert(!op.is_axiom());
+    assert(compiled_task.is_applicable(op.get_id(), *this));
+    assert(values);
+    vector<int> new_values = get_unpacked_values();
+    apply_effects_and_axioms(
+        *task, new_values, [&](const auto &callback) {
+            compiled_task.for_each_firing_effect(op.get_id(), *this, callback);
+        });
     return State(*task, move(new_values));
 }
 
@@ -39,6 +39,10 @@ namespace causal_graph {
 class CausalGraph;
 }
 
+namespace compiled_task {
+class CompiledTask;
+}
+
 using PackedStateBin = int_packer::IntPacker::Bin;
 
 /*
@@ -631,6 +635,17 @@ public:
       unpack() to ensure the data exists.
     */
     State get_unregistered_successor(const OperatorProxy &op) const;
+
+    /*
+      Like get_unregistered_successor(op), but read the effects of the
+      operator from the given snapshot of the task, which avoids virtual
+      calls. Code that generates many successors should look up the
+      snapshot once (see compiled_task::g_compiled_tasks) and use this
+      variant.
+    */
+    State get_unregistered_successor(
+        const OperatorProxy &op,
+        const compiled_task::CompiledTask &compiled_task) const;
 };
 
 
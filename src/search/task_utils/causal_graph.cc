@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -30,6 +31,7 @@ using namespace std;
 namespace causal_graph {
 static unordered_map<const AbstractTask *,
                      unique_ptr<CausalGraph>> causal_graph_cache;
+static mutex causal_graph_cache_mutex;
 
 /*
   An IntRelationBuilder constructs an IntRelation by adding one pair
@@ -204,6 +206,7 @@ void CausalGraph::dump(const TaskProxy &task_proxy) const {
 }
 
 const CausalGraph &get_causal_graph(const AbstractTask *task) {
+    lock_guard<mutex> lock(causal_graph_cache_mutex);
     if (causal_graph_cache.count(task) == 0) {
         TaskProxy task_proxy(*task);
         causal_graph_cache.insert(
@@ -0,0 +1,37 @@
+#include "compiled_task.h"
+
+using namespace std;
+
+namespace compiled_task {
+CompiledTask::CompiledTask(const TaskProxy &task_proxy) {
+    OperatorsProxy operators = task_proxy.get_operators();
+    int num_operators = operators.size();
+    operator_costs.reserve(num_operators);
+    precondition_offsets.reserve(num_operators + 1);
+    effect_offsets.reserve(num_operators + 1);
+    precondition_offsets.push_back(0);
+    effect_offsets.push_back(0);
+    effect_condition_offsets.push_back(0);
+    for (OperatorProxy op : operators) {
+        operator_costs.push_back(op.get_cost());
+        for (FactProxy precondition : op.get_preconditions()) {
+            preconditions.push_back(precondition.get_pair());
+        }
+        precondition_offsets.push_back(preconditions.size());
+        for (EffectProxy effect : op.get_effects()) {
+            effects.push_back(effect.get_fact().get_pair());
+            for (FactProxy condition : effect.get_conditions()) {
+                effect_conditions.push_back(condition.get_pair());
+            }
+            effect_condition_offsets.push_back(effect_conditions.size());
+        }
+        effect_offsets.push_back(effects.size());
+    }
+    preconditions.shrink_to_fit();
+    effects.shrink_to_fit();
+    effect_condition_offsets.shrink_to_fit();
+    effect_conditions.shrink_to_fit();
+}
+
+PerTaskInformation<CompiledTask> g_compiled_tasks;
+}
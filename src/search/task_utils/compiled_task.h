@@ -0,0 +1,114 @@
+#ifndef TASK_UTILS_COMPILED_TASK_H
+#define TASK_UTILS_COMPILED_TASK_H
+
+#include "../per_task_information.h"
+#include "../task_proxy.h"
+
+#include <cassert>
+#include <span>
+#include <vector>
+
+namespace compiled_task {
+/*
+  Snapshot of the operators of a task, stored in contiguous arrays in
+  compressed sparse row format: the preconditions of operator op are
+  preconditions[precondition_offsets[op]], ...,
+  preconditions[precondition_offsets[op + 1] - 1], and analogously for the
+  effects of each operator and the conditions of each effect.
+
+  Accessing operators through TaskProxy costs one virtual call per fact, and
+  task transformations add further calls for each of them. Code on hot paths
+  such as successor generation can use the snapshot instead, which avoids
+  all virtual calls. Since tasks do not change after construction, the
+  snapshot can be computed once per task. Axioms are not included because
+  they are only used by the AxiomEvaluator, which has its own data
+  structures.
+*/
+class CompiledTask {
+    std::vector<int> operator_costs;
+    std::vector<int> precondition_offsets;
+    std::vector<FactPair> preconditions;
+    std::vector<int> effect_offsets;
+    std::vector<FactPair> effects;
+    // Offsets by effect, i.e., indexed by effect_offsets[op] + effect.
+    std::vector<int> effect_condition_offsets;
+    std::vector<FactPair> effect_conditions;
+
+    bool does_effect_fire(int effect, const State &state) const {
+        for (int i = effect_condition_offsets[effect];
+             i < effect_condition_offsets[effect + 1]; ++i) {
+            const FactPair &condition = effect_conditions[i];
+            if (state[condition.var].get_value() != condition.value)
+                return false;
+        }
+        return true;
+    }
+public:
+    explicit CompiledTask(const TaskProxy &task_proxy);
+
+    int get_num_operators() const {
+        return operator_costs.size();
+    }
+
+    int get_operator_cost(int op_id) const {
+        assert(utils::in_bounds(op_id, operator_costs));
+        return operator_costs[op_id];
+    }
+
+    std::span<const FactPair> get_preconditions(int op_id) const {
+        assert(utils::in_bounds(op_id, operator_costs));
+        return std::span<const FactPair>(
+            preconditions.data() + precondition_offsets[op_id],
+            preconditions.data() + precondition_offsets[op_id + 1]);
+    }
+
+    // Return the facts made true by the effects of the operator.
+    std::span<const FactPair> get_effects(int op_id) const {
+        assert(utils::in_bounds(op_id, operator_costs));
+        return std::span<const FactPair>(
+            effects.data() + effect_offsets[op_id],
+            effects.data() + effect_offsets[op_id + 1]);
+    }
+
+    std::span<const FactPair> get_effect_conditions(int op_id, int eff_id) const {
+        int effect = effect_offsets[op_id] + eff_id;
+        assert(effect < effect_offsets[op_id + 1]);
+        return std::span<const FactPair>(
+            effect_conditions.data() + effect_condition_offsets[effect],
+            effect_conditions.data() + effect_condition_offsets[effect + 1]);
+    }
+
+    bool has_conditional_effects() const {
+        return !effect_conditions.empty();
+    }
+
+    bool is_applicable(int op_id, const State &state) const {
+        for (const FactPair &precondition : get_preconditions(op_id)) {
+            if (state[precondition.var].get_value() != precondition.value)
+                return false;
+        }
+        return true;
+    }
+
+    /*
+      Call callback(fact) for each effect of the operator that fires in the
+      given state, where fact is the fact made true by the effect.
+    */
+    template<typename Callback>
+    void for_each_firing_effect(
+        int op_id, const State &state, const Callback &callback) const {
+        assert(utils::in_bounds(op_id, operator_costs));
+        int end = effect_offsets[op_id + 1];
+        bool conditional = has_conditional_effects();
+        for (int effect = effect_offsets[op_id]; effect < end; ++effect) {
+            if (!conditional || does_effect_fire(effect, state)) {
+                callback(effects[effect]);
+            }
+        }
+    }
+};
+
+extern PerTaskInformation<CompiledTask> g_compiled_tasks;
+}
+
+#endif
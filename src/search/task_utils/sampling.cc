@@ -1,5 +1,6 @@
 #include "sampling.h"
 
+#include "compiled_task.h"
 #include "successor_generator.h"
 
 #include "../task_proxy.h"
@@ -14,6 +15,7 @@ using namespace std;
 namespace sampling {
 static State sample_state_with_random_walk(
     const OperatorsProxy &operators,
+    const compiled_task::CompiledTask &compiled_task,
     const State &initial_state,
     const successor_generator::SuccessorGenerator &successor_generator,
     int init_h,
@@ -61,7 +63,8 @@ static State sample_state_with_random_walk(
             OperatorID random_op_id = *rng.choose(applicable_operators);
             OperatorProxy random_op = operators[random_op_id];
             assert(task_properties::is_applicable(random_op, current_state));
-            current_state = current_state.get_unregistered_successor(random_op);
+            current_state = current_state.get_unregistered_successor(
+                random_op, compiled_task);
             /* If current state is a dead end, then restart the random walk
                with the initial state. */
             if (is_dead_end(current_state)) {
@@ -78,6 +81,7 @@ RandomWalkSampler::RandomWalkSampler(
     const TaskProxy &task_proxy,
     utils::RandomNumberGenerator &rng)
     : operators(task_proxy.get_operators()),
+      compiled_task(compiled_task::g_compiled_tasks[task_proxy]),
       successor_generator(utils::make_unique_ptr<successor_generator::SuccessorGenerator>(task_proxy)),
       initial_state(task_proxy.get_initial_state()),
       average_operator_costs(task_properties::get_average_operator_cost(task_proxy)),
@@ -91,6 +95,7 @@ State RandomWalkSampler::sample_state(
     int init_h, const DeadEndDetector &is_dead_end) const {
     return sample_state_with_random_walk(
         operators,
+        compiled_task,
         initial_state,
         *successor_generator,
         init_h,
@@ -8,6 +8,10 @@
 
 class State;
 
+namespace compiled_task {
+class CompiledTask;
+}
+
 namespace successor_generator {
 class SuccessorGenerator;
 }
@@ -24,6 +28,7 @@ namespace sampling {
 */
 class RandomWalkSampler {
     const OperatorsProxy operators;
+    const compiled_task::CompiledTask &compiled_task;
     const std::unique_ptr<successor_generator::SuccessorGenerator> successor_generator;
     const State initial_state;
     const double average_operator_costs;
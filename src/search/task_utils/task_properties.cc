@@ -175,7 +175,15 @@ PerTaskInformation<int_packer::IntPacker> g_state_packers(
         for (VariableProxy var : variables) {
             variable_ranges.push_back(var.get_domain_size());
         }
-        return utils::make_unique_ptr<int_packer::IntPacker>(variable_ranges);
+        // Place the variables that operators change most often together.
+        vector<int> effect_frequencies(variables.size(), 0);
+        for (OperatorProxy op : task_proxy.get_operators()) {
+            for (EffectProxy effect : op.get_effects()) {
+                ++effect_frequencies[effect.get_fact().get_variable().get_id()];
+            }
+        }
+        return utils::make_unique_ptr<int_packer::IntPacker>(
+            variable_ranges, effect_frequencies);
     }
     );
 }
@@ -4,15 +4,27 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/collections.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <charconv>
+#include <cstring>
 #include <memory>
-#include <set>
+#include <span>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 using namespace std;
 using utils::ExitCode;
@@ -21,6 +33,82 @@ namespace tasks {
 static const int PRE_FILE_VERSION = 3;
 shared_ptr<AbstractTask> g_root_task = nullptr;
 
+static vector<char> read_complete_input(istream &in) {
+    const size_t chunk_size = 1 << 20;
+    vector<char> buffer;
+    size_t size = 0;
+    do {
+        buffer.resize(size + chunk_size);
+        in.read(buffer.data() + size, chunk_size);
+        size += in.gcount();
+    } while (in);
+    buffer.resize(size);
+    return buffer;
+}
+
+/*
+  Scanner for the translator output. It reads the complete input into a
+  buffer and parses it without formatted stream extraction, which is much
+  faster for large tasks. Words and lines are treated as by operator>> and
+  getline.
+*/
+class InputScanner {
+    vector<char> buffer;
+    const char *pos;
+    const char *end;
+
+    static bool is_whitespace(char c) {
+        return isspace(static_cast<unsigned char>(c));
+    }
+public:
+    explicit InputScanner(istream &in)
+        : buffer(read_complete_input(in)),
+          pos(buffer.data()),
+          end(buffer.data() + buffer.size()) {
+    }
+
+    void skip_whitespace() {
+        while (pos != end && is_whitespace(*pos)) {
+            ++pos;
+        }
+    }
+
+    string_view read_word() {
+        skip_whitespace();
+        const char *begin = pos;
+        while (pos != end && !is_whitespace(*pos)) {
+            ++pos;
+        }
+        return string_view(begin, pos - begin);
+    }
+
+    int read_int() {
+        skip_whitespace();
+        int value;
+        auto [next, error] = from_chars(pos, end, value);
+        if (error != errc()) {
+            cerr << "Failed to read integer." << endl
+                 << "Got '" << read_word() << "'." << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        pos = next;
+        return value;
+    }
+
+    // Read the rest of the current line without the line break.
+    string read_line() {
+        const char *begin = pos;
+        while (pos != end && *pos != '\n') {
+            ++pos;
+        }
+        string line(begin, pos);
+        if (pos != end) {
+            ++pos;
+        }
+        return line;
+    }
+};
+
 struct ExplicitVariable {
     int domain_size;
     string name;
@@ -28,7 +116,7 @@ struct ExplicitVariable {
     int axiom_layer;
     int axiom_default_value;
 
-    explicit ExplicitVariable(istream &in);
+    explicit ExplicitVariable(InputScanner &in);
 };
 
 
@@ -47,15 +135,16 @@ struct ExplicitOperator {
     string name;
     bool is_an_axiom;
 
-    void read_pre_post(istream &in);
-    ExplicitOperator(istream &in, bool is_an_axiom, bool use_metric);
+    void read_pre_post(InputScanner &in);
+    ExplicitOperator(InputScanner &in, bool is_an_axiom, bool use_metric);
 };
 
 
 class RootTask : public AbstractTask {
     vector<ExplicitVariable> variables;
     // TODO: think about using hash sets here.
-    vector<vector<set<FactPair>>> mutexes;
+    // Sorted lists of mutex facts by fact.
+    vector<vector<vector<FactPair>>> mutexes;
     vector<ExplicitOperator> operators;
     vector<ExplicitOperator> axioms;
     vector<int> initial_state_values;
@@ -68,6 +157,8 @@ class RootTask : public AbstractTask {
 public:
     explicit RootTask(istream &in);
 
+    void write_binary(ostream &out) const;
+
     virtual int get_num_variables() const override;
     virtual string get_variable_name(int var) const override;
     virtual int get_variable_domain_size(int var) const override;
@@ -133,9 +224,8 @@ static void check_facts(const ExplicitOperator &action, const vector<ExplicitVar
     }
 }
 
-void check_magic(istream &in, const string &magic) {
-    string word;
-    in >> word;
+void check_magic(InputScanner &in, const string &magic) {
+    string_view word = in.read_word();
     if (word != magic) {
         cerr << "Failed to match magic word '" << magic << "'." << endl
              << "Got '" << word << "'." << endl;
@@ -148,28 +238,27 @@ void check_magic(istream &in, const string &magic) {
     }
 }
 
-vector<FactPair> read_facts(istream &in) {
-    int count;
-    in >> count;
+vector<FactPair> read_facts(InputScanner &in) {
+    int count = in.read_int();
     vector<FactPair> conditions;
     conditions.reserve(count);
     for (int i = 0; i < count; ++i) {
-        FactPair condition = FactPair::no_fact;
-        in >> condition.var >> condition.value;
-        conditions.push_back(condition);
+        int var = in.read_int();
+        int value = in.read_int();
+        conditions.emplace_back(var, value);
     }
     return conditions;
 }
 
-ExplicitVariable::ExplicitVariable(istream &in) {
+ExplicitVariable::ExplicitVariable(InputScanner &in) {
     check_magic(in, "begin_variable");
-    in >> name;
-    in >> axiom_layer;
-    in >> domain_size;
-    in >> ws;
+    name = in.read_word();
+    axiom_layer = in.read_int();
+    domain_size = in.read_int();
+    in.skip_whitespace();
     fact_names.resize(domain_size);
     for (int i = 0; i < domain_size; ++i)
-        getline(in, fact_names[i]);
+        fact_names[i] = in.read_line();
     check_magic(in, "end_variable");
 }
 
@@ -180,32 +269,31 @@ ExplicitEffect::ExplicitEffect(
 }
 
 
-void ExplicitOperator::read_pre_post(istream &in) {
+void ExplicitOperator::read_pre_post(InputScanner &in) {
     vector<FactPair> conditions = read_facts(in);
-    int var, value_pre, value_post;
-    in >> var >> value_pre >> value_post;
+    int var = in.read_int();
+    int value_pre = in.read_int();
+    int value_post = in.read_int();
     if (value_pre != -1) {
         preconditions.emplace_back(var, value_pre);
     }
     effects.emplace_back(var, value_post, move(conditions));
 }
 
-ExplicitOperator::ExplicitOperator(istream &in, bool is_an_axiom, bool use_metric)
+ExplicitOperator::ExplicitOperator(InputScanner &in, bool is_an_axiom, bool use_metric)
     : is_an_axiom(is_an_axiom) {
     if (!is_an_axiom) {
         check_magic(in, "begin_operator");
-        in >> ws;
-        getline(in, name);
+        in.skip_whitespace();
+        name = in.read_line();
         preconditions = read_facts(in);
-        int count;
-        in >> count;
+        int count = in.read_int();
         effects.reserve(count);
         for (int i = 0; i < count; ++i) {
             read_pre_post(in);
         }
 
-        int op_cost;
-        in >> op_cost;
+        int op_cost = in.read_int();
         cost = use_metric ? op_cost : 1;
         check_magic(in, "end_operator");
     } else {
@@ -218,10 +306,9 @@ ExplicitOperator::ExplicitOperator(istream &in, bool is_an_axiom, bool use_metri
     assert(cost >= 0);
 }
 
-void read_and_verify_version(istream &in) {
-    int version;
+void read_and_verify_version(InputScanner &in) {
     check_magic(in, "begin_version");
-    in >> version;
+    int version = in.read_int();
     check_magic(in, "end_version");
     if (version != PRE_FILE_VERSION) {
         cerr << "Expected translator output file version " << PRE_FILE_VERSION
@@ -231,17 +318,15 @@ void read_and_verify_version(istream &in) {
     }
 }
 
-bool read_metric(istream &in) {
-    bool use_metric;
+bool read_metric(InputScanner &in) {
     check_magic(in, "begin_metric");
-    in >> use_metric;
+    bool use_metric = in.read_int();
     check_magic(in, "end_metric");
     return use_metric;
 }
 
-vector<ExplicitVariable> read_variables(istream &in) {
-    int count;
-    in >> count;
+vector<ExplicitVariable> read_variables(InputScanner &in) {
+    int count = in.read_int();
     vector<ExplicitVariable> variables;
     variables.reserve(count);
     for (int i = 0; i < count; ++i) {
@@ -250,31 +335,27 @@ vector<ExplicitVariable> read_variables(istream &in) {
     return variables;
 }
 
-vector<vector<set<FactPair>>> read_mutexes(istream &in, const vector<ExplicitVariable> &variables) {
-    vector<vector<set<FactPair>>> inconsistent_facts(variables.size());
+vector<vector<vector<FactPair>>> read_mutexes(InputScanner &in, const vector<ExplicitVariable> &variables) {
+    vector<vector<vector<FactPair>>> inconsistent_facts(variables.size());
     for (size_t i = 0; i < variables.size(); ++i)
         inconsistent_facts[i].resize(variables[i].domain_size);
 
-    int num_mutex_groups;
-    in >> num_mutex_groups;
+    int num_mutex_groups = in.read_int();
 
     /*
       NOTE: Mutex groups can overlap, in which case the same mutex
-      should not be represented multiple times. The current
-      representation takes care of that automatically by using sets.
-      If we ever change this representation, this is something to be
-      aware of.
+      should not be represented multiple times. We therefore sort the
+      mutexes of each fact and remove duplicates after reading all
+      mutex groups.
     */
     for (int i = 0; i < num_mutex_groups; ++i) {
         check_magic(in, "begin_mutex_group");
-        int num_facts;
-        in >> num_facts;
+        int num_facts = in.read_int();
         vector<FactPair> invariant_group;
         invariant_group.reserve(num_facts);
         for (int j = 0; j < num_facts; ++j) {
-            int var;
-            int value;
-            in >> var >> value;
+            int var = in.read_int();
+            int value = in.read_int();
             invariant_group.emplace_back(var, value);
         }
         check_magic(in, "end_mutex_group");
@@ -291,15 +372,21 @@ vector<vector<set<FactPair>>> read_mutexes(istream &in, const vector<ExplicitVar
                        can of course generate mutex groups which lead
                        to *some* redundant mutexes, where some but not
                        all facts talk about the same variable. */
-                    inconsistent_facts[fact1.var][fact1.value].insert(fact2);
+                    inconsistent_facts[fact1.var][fact1.value].push_back(fact2);
                 }
             }
         }
     }
+    for (vector<vector<FactPair>> &inconsistent_facts_by_value : inconsistent_facts) {
+        for (vector<FactPair> &facts : inconsistent_facts_by_value) {
+            utils::sort_unique(facts);
+            facts.shrink_to_fit();
+        }
+    }
     return inconsistent_facts;
 }
 
-vector<FactPair> read_goal(istream &in) {
+vector<FactPair> read_goal(InputScanner &in) {
     check_magic(in, "begin_goal");
     vector<FactPair> goals = read_facts(in);
     check_magic(in, "end_goal");
@@ -311,10 +398,9 @@ vector<FactPair> read_goal(istream &in) {
 }
 
 vector<ExplicitOperator> read_actions(
-    istream &in, bool is_axiom, bool use_metric,
+    InputScanner &in, bool is_axiom, bool use_metric,
     const vector<ExplicitVariable> &variables) {
-    int count;
-    in >> count;
+    int count = in.read_int();
     vector<ExplicitOperator> actions;
     actions.reserve(count);
     for (int i = 0; i < count; ++i) {
@@ -324,7 +410,8 @@ vector<ExplicitOperator> read_actions(
     return actions;
 }
 
-RootTask::RootTask(istream &in) {
+RootTask::RootTask(istream &input) {
+    InputScanner in(input);
     read_and_verify_version(in);
     bool use_metric = read_metric(in);
     variables = read_variables(in);
@@ -335,7 +422,7 @@ RootTask::RootTask(istream &in) {
     initial_state_values.resize(num_variables);
     check_magic(in, "begin_state");
     for (int i = 0; i < num_variables; ++i) {
-        in >> initial_state_values[i];
+        initial_state_values[i] = in.read_int();
     }
     check_magic(in, "end_state");
 
@@ -348,7 +435,7 @@ RootTask::RootTask(istream &in) {
     operators = read_actions(in, false, use_metric, variables);
     axioms = read_actions(in, true, use_metric, variables);
     /* TODO: We should be stricter here and verify that we
-       have reached the end of "in". */
+       have reached the end of the input. */
 
     /*
       HACK: We use a TaskProxy to access g_axiom_evaluators here which assumes
@@ -413,7 +500,8 @@ bool RootTask::are_facts_mutex(const FactPair &fact1, const FactPair &fact2) con
     }
     assert(utils::in_bounds(fact1.var, mutexes));
     assert(utils::in_bounds(fact1.value, mutexes[fact1.var]));
-    return bool(mutexes[fact1.var][fact1.value].count(fact2));
+    const vector<FactPair> &mutex_facts = mutexes[fact1.var][fact1.value];
+    return binary_search(mutex_facts.begin(), mutex_facts.end(), fact2);
 }
 
 int RootTask::get_operator_cost(int index, bool is_axiom) const {
@@ -492,9 +580,682 @@ void RootTask::convert_ancestor_state_values(
     }
 }
 
+/*
+  Binary task format: the magic bytes are followed by 32-bit integers in
+  native byte order, namely the format version, a byte order mark and the
+  sections in the order written by RootTask::write_binary. Arrays are stored
+  as their length followed by their elements. Lists of facts are stored as an
+  array of offsets into an array of facts, where each fact is stored as
+  variable and value. String tables are stored as an array of offsets
+  followed by the characters, padded to a multiple of four bytes.
+
+  Since all arrays are aligned in the file, a task in binary format can be
+  accessed in memory without converting it.
+*/
+static const char BINARY_MAGIC[8] = {'\x7f', 'F', 'D', 'T', 'A', 'S', 'K', '\n'};
+static const int BINARY_FILE_VERSION = 1;
+static const int BINARY_BYTE_ORDER_MARK = 0x01020304;
+
+class BinaryTaskWriter {
+    ostream &out;
+public:
+    explicit BinaryTaskWriter(ostream &out)
+        : out(out) {
+        out.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        write_int(BINARY_FILE_VERSION);
+        write_int(BINARY_BYTE_ORDER_MARK);
+    }
+
+    void write_int(int value) {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(int));
+    }
+
+    void write_array(const vector<int> &values) {
+        write_int(values.size());
+        out.write(reinterpret_cast<const char *>(values.data()),
+                  values.size() * sizeof(int));
+    }
+
+    void write_strings(const vector<string> &strings) {
+        vector<int> offsets;
+        offsets.reserve(strings.size() + 1);
+        offsets.push_back(0);
+        for (const string &str : strings) {
+            offsets.push_back(offsets.back() + str.size());
+        }
+        write_array(offsets);
+        for (const string &str : strings) {
+            out.write(str.data(), str.size());
+        }
+        static const char padding[sizeof(int)] = {};
+        out.write(padding, (sizeof(int) - offsets.back() % sizeof(int)) % sizeof(int));
+    }
+};
+
+class FactListsBuilder {
+    vector<int> offsets;
+    vector<int> facts;
+public:
+    FactListsBuilder()
+        : offsets(1, 0) {
+    }
+
+    void add_fact(const FactPair &fact) {
+        facts.push_back(fact.var);
+        facts.push_back(fact.value);
+    }
+
+    // Finish the current list. Facts added afterwards belong to the next list.
+    void finish_list() {
+        offsets.push_back(facts.size() / 2);
+    }
+
+    template<typename Facts>
+    void add_list(const Facts &list) {
+        for (const FactPair &fact : list) {
+            add_fact(fact);
+        }
+        finish_list();
+    }
+
+    void write(BinaryTaskWriter &writer) const {
+        writer.write_array(offsets);
+        writer.write_array(facts);
+    }
+};
+
+static void write_actions(
+    BinaryTaskWriter &writer, const vector<ExplicitOperator> &actions) {
+    vector<int> costs;
+    vector<string> names;
+    FactListsBuilder preconditions;
+    FactListsBuilder effects;
+    FactListsBuilder effect_conditions;
+    costs.reserve(actions.size());
+    names.reserve(actions.size());
+    for (const ExplicitOperator &action : actions) {
+        costs.push_back(action.cost);
+        names.push_back(action.name);
+        preconditions.add_list(action.preconditions);
+        for (const ExplicitEffect &effect : action.effects) {
+            effects.add_fact(effect.fact);
+            effect_conditions.add_list(effect.conditions);
+        }
+        effects.finish_list();
+    }
+    writer.write_array(costs);
+    writer.write_strings(names);
+    preconditions.write(writer);
+    effects.write(writer);
+    effect_conditions.write(writer);
+}
+
+void RootTask::write_binary(ostream &out) const {
+    BinaryTaskWriter writer(out);
+    vector<int> domain_sizes;
+    vector<int> axiom_layers;
+    vector<int> axiom_default_values;
+    vector<string> variable_names;
+    vector<string> fact_names;
+    FactListsBuilder mutex_lists;
+    for (size_t var = 0; var < variables.size(); ++var) {
+        const ExplicitVariable &variable = variables[var];
+        domain_sizes.push_back(variable.domain_size);
+        axiom_layers.push_back(variable.axiom_layer);
+        axiom_default_values.push_back(variable.axiom_default_value);
+        variable_names.push_back(variable.name);
+        fact_names.insert(fact_names.end(), variable.fact_names.begin(),
+                          variable.fact_names.end());
+        for (const vector<FactPair> &mutex_facts : mutexes[var]) {
+            mutex_lists.add_list(mutex_facts);
+        }
+    }
+    writer.write_array(domain_sizes);
+    writer.write_array(axiom_layers);
+    writer.write_array(axiom_default_values);
+    writer.write_strings(variable_names);
+    writer.write_strings(fact_names);
+    mutex_lists.write(writer);
+    writer.write_array(initial_state_values);
+    FactListsBuilder goal_list;
+    goal_list.add_list(goals);
+    goal_list.write(writer);
+    write_actions(writer, operators);
+    write_actions(writer, axioms);
+}
+
+
+/*
+  Memory holding a task in binary format, which is either mapped from the
+  input file or read into a buffer.
+*/
+class BinaryTaskData {
+    vector<char> buffer;
+    void *mapped_data;
+    size_t mapped_size;
+public:
+    explicit BinaryTaskData(istream &in)
+        : buffer(read_complete_input(in)),
+          mapped_data(nullptr),
+          mapped_size(0) {
+    }
+
+    // Take ownership of memory mapped with mmap.
+    BinaryTaskData(void *mapped_data, size_t mapped_size)
+        : mapped_data(mapped_data),
+          mapped_size(mapped_size) {
+    }
+
+    ~BinaryTaskData() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+        if (mapped_data) {
+            munmap(mapped_data, mapped_size);
+        }
+#endif
+    }
+
+    BinaryTaskData(const BinaryTaskData &) = delete;
+    BinaryTaskData &operator=(const BinaryTaskData &) = delete;
+
+    const char *get_data() const {
+        return mapped_data ? static_cast<const char *>(mapped_data) : buffer.data();
+    }
+
+    size_t get_size() const {
+        return mapped_data ? mapped_size : buffer.size();
+    }
+};
+
+static void binary_input_error(const string &message) {
+    cerr << "Invalid binary task: " << message << endl;
+    utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+}
+
+class StringTable {
+    span<const int> offsets;
+    const char *chars;
+public:
+    StringTable()
+        : chars(nullptr) {
+    }
+
+    StringTable(span<const int> offsets, const char *chars)
+        : offsets(offsets), chars(chars) {
+    }
+
+    int size() const {
+        return offsets.size() - 1;
+    }
+
+    string operator[](int index) const {
+        assert(index >= 0 && index < size());
+        return string(chars + offsets[index], chars + offsets[index + 1]);
+    }
+};
+
+class FactLists {
+    span<const int> offsets;
+    span<const int> facts;
+public:
+    FactLists() = default;
+
+    FactLists(span<const int> offsets, span<const int> facts)
+        : offsets(offsets), facts(facts) {
+    }
+
+    int get_num_lists() const {
+        return offsets.size() - 1;
+    }
+
+    int get_begin(int list) const {
+        assert(list >= 0 && list < get_num_lists());
+        return offsets[list];
+    }
+
+    int get_end(int list) const {
+        assert(list >= 0 && list < get_num_lists());
+        return offsets[list + 1];
+    }
+
+    FactPair get_fact(int index) const {
+        assert(index >= 0 && 2 * index < static_cast<int>(facts.size()));
+        return FactPair(facts[2 * index], facts[2 * index + 1]);
+    }
+
+    FactPair get_fact(int list, int index) const {
+        assert(index >= 0 && index < get_end(list) - get_begin(list));
+        return get_fact(get_begin(list) + index);
+    }
+
+    int get_num_facts() const {
+        return facts.size() / 2;
+    }
+};
+
+class BinaryTaskReader {
+    const char *pos;
+    const char *end;
+
+    void check_remaining_size(size_t size) const {
+        if (static_cast<size_t>(end - pos) < size) {
+            binary_input_error("unexpected end of file");
+        }
+    }
+public:
+    explicit BinaryTaskReader(const BinaryTaskData &data)
+        : pos(data.get_data()),
+          end(data.get_data() + data.get_size()) {
+        check_remaining_size(sizeof(BINARY_MAGIC));
+        if (memcmp(pos, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+            binary_input_error("failed to match magic bytes");
+        }
+        pos += sizeof(BINARY_MAGIC);
+        int version = read_int();
+        if (version != BINARY_FILE_VERSION) {
+            cerr << "Expected binary task file version " << BINARY_FILE_VERSION
+                 << ", got " << version << "." << endl
+                 << "Exiting." << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        if (read_int() != BINARY_BYTE_ORDER_MARK) {
+            binary_input_error("file was written on a machine with different byte order");
+        }
+    }
+
+    int read_int() {
+        check_remaining_size(sizeof(int));
+        int value;
+        memcpy(&value, pos, sizeof(int));
+        pos += sizeof(int);
+        return value;
+    }
+
+    span<const int> read_array() {
+        int size = read_int();
+        if (size < 0) {
+            binary_input_error("negative array size");
+        }
+        check_remaining_size(size * sizeof(int));
+        span<const int> array(reinterpret_cast<const int *>(pos), size);
+        pos += size * sizeof(int);
+        return array;
+    }
+
+    span<const int> read_array(int expected_size) {
+        span<const int> array = read_array();
+        if (static_cast<int>(array.size()) != expected_size) {
+            binary_input_error("unexpected array size");
+        }
+        return array;
+    }
+
+    // Offsets must start at 0 and be non-decreasing.
+    span<const int> read_offsets(int num_entries) {
+        span<const int> offsets = read_array(num_entries + 1);
+        if (offsets[0] != 0 || !is_sorted(offsets.begin(), offsets.end())) {
+            binary_input_error("invalid offsets");
+        }
+        return offsets;
+    }
+
+    StringTable read_strings(int num_strings) {
+        span<const int> offsets = read_offsets(num_strings);
+        size_t num_chars = offsets.back();
+        size_t padded_size = (num_chars + sizeof(int) - 1) / sizeof(int) * sizeof(int);
+        check_remaining_size(padded_size);
+        StringTable strings(offsets, pos);
+        pos += padded_size;
+        return strings;
+    }
+
+    FactLists read_fact_lists(int num_lists) {
+        span<const int> offsets = read_offsets(num_lists);
+        span<const int> facts = read_array(2 * offsets.back());
+        return FactLists(offsets, facts);
+    }
+
+    void check_end() const {
+        if (pos != end) {
+            binary_input_error("unexpected data after end of task");
+        }
+    }
+};
+
+struct BinaryActions {
+    span<const int> costs;
+    StringTable names;
+    FactLists preconditions;
+    // Lists of effects by action and lists of effect conditions by effect.
+    FactLists effects;
+    FactLists effect_conditions;
+
+    explicit BinaryActions(BinaryTaskReader &reader) {
+        costs = reader.read_array();
+        int num_actions = costs.size();
+        names = reader.read_strings(num_actions);
+        preconditions = reader.read_fact_lists(num_actions);
+        effects = reader.read_fact_lists(num_actions);
+        effect_conditions = reader.read_fact_lists(effects.get_num_facts());
+        if (any_of(costs.begin(), costs.end(), [](int cost) {return cost < 0;})) {
+            binary_input_error("negative action cost");
+        }
+    }
+
+    int get_effect_index(int action, int effect) const {
+        assert(effect >= 0 &&
+               effect < effects.get_end(action) - effects.get_begin(action));
+        return effects.get_begin(action) + effect;
+    }
+};
+
+/*
+  Root task that accesses a task in binary format directly in memory. Apart
+  from the offsets of the variables in the list of facts, it does not copy
+  any data.
+*/
+class BinaryRootTask : public AbstractTask {
+    unique_ptr<BinaryTaskData> data;
+    span<const int> domain_sizes;
+    span<const int> axiom_layers;
+    span<const int> axiom_default_values;
+    StringTable variable_names;
+    StringTable fact_names;
+    vector<int> fact_offsets;
+    // Sorted lists of mutex facts by fact.
+    FactLists mutexes;
+    span<const int> initial_state_values;
+    FactLists goals;
+    unique_ptr<BinaryActions> operators;
+    unique_ptr<BinaryActions> axioms;
+
+    int get_fact_id(const FactPair &fact) const {
+        assert(utils::in_bounds(fact.var, domain_sizes));
+        assert(fact.value >= 0 && fact.value < domain_sizes[fact.var]);
+        return fact_offsets[fact.var] + fact.value;
+    }
+
+    const BinaryActions &get_actions(bool is_axiom) const {
+        return is_axiom ? *axioms : *operators;
+    }
+
+    void check_facts(const FactLists &lists) const;
+public:
+    explicit BinaryRootTask(unique_ptr<BinaryTaskData> &&data);
+
+    void write_binary(ostream &out) const;
+
+    virtual int get_num_variables() const override;
+    virtual string get_variable_name(int var) const override;
+    virtual int get_variable_domain_size(int var) const override;
+    virtual int get_variable_axiom_layer(int var) const override;
+    virtual int get_variable_default_axiom_value(int var) const override;
+    virtual string get_fact_name(const FactPair &fact) const override;
+    virtual bool are_facts_mutex(
+        const FactPair &fact1, const FactPair &fact2) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override;
+    virtual string get_operator_name(
+        int index, bool is_axiom) const override;
+    virtual int get_num_operators() const override;
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override;
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override;
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual int convert_operator_index(
+        int index, const AbstractTask *ancestor_task) const override;
+
+    virtual int get_num_axioms() const override;
+
+    virtual int get_num_goals() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual vector<int> get_initial_state_values() const override;
+    virtual void convert_ancestor_state_values(
+        vector<int> &values,
+        const AbstractTask *ancestor_task) const override;
+};
+
+BinaryRootTask::BinaryRootTask(unique_ptr<BinaryTaskData> &&data_)
+    : data(move(data_)) {
+    BinaryTaskReader reader(*data);
+    domain_sizes = reader.read_array();
+    int num_variables = domain_sizes.size();
+    axiom_layers = reader.read_array(num_variables);
+    axiom_default_values = reader.read_array(num_variables);
+    variable_names = reader.read_strings(num_variables);
+
+    fact_offsets.reserve(num_variables + 1);
+    fact_offsets.push_back(0);
+    for (int domain_size : domain_sizes) {
+        if (domain_size <= 0) {
+            binary_input_error("invalid domain size");
+        }
+        fact_offsets.push_back(fact_offsets.back() + domain_size);
+    }
+    int num_facts = fact_offsets.back();
+    fact_names = reader.read_strings(num_facts);
+    mutexes = reader.read_fact_lists(num_facts);
+    initial_state_values = reader.read_array(num_variables);
+    goals = reader.read_fact_lists(1);
+    operators = utils::make_unique_ptr<BinaryActions>(reader);
+    axioms = utils::make_unique_ptr<BinaryActions>(reader);
+    reader.check_end();
+
+    for (int var = 0; var < num_variables; ++var) {
+        for (int value : {axiom_default_values[var], initial_state_values[var]}) {
+            if (value < 0 || value >= domain_sizes[var]) {
+                cerr << "Invalid value for variable " << var << ": "
+                     << value << endl;
+                utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+            }
+        }
+    }
+    check_facts(mutexes);
+    check_facts(goals);
+    if (goals.get_num_facts() == 0) {
+        cerr << "Task has no goal condition!" << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    for (const BinaryActions *actions : {operators.get(), axioms.get()}) {
+        check_facts(actions->preconditions);
+        check_facts(actions->effects);
+        check_facts(actions->effect_conditions);
+    }
+}
+
+void BinaryRootTask::check_facts(const FactLists &lists) const {
+    for (int i = 0; i < lists.get_num_facts(); ++i) {
+        FactPair fact = lists.get_fact(i);
+        if (!utils::in_bounds(fact.var, domain_sizes)) {
+            cerr << "Invalid variable id: " << fact.var << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        if (fact.value < 0 || fact.value >= domain_sizes[fact.var]) {
+            cerr << "Invalid value for variable " << fact.var << ": " << fact.value << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+    }
+}
+
+void BinaryRootTask::write_binary(ostream &out) const {
+    out.write(data->get_data(), data->get_size());
+}
+
+int BinaryRootTask::get_num_variables() const {
+    return domain_sizes.size();
+}
+
+string BinaryRootTask::get_variable_name(int var) const {
+    return variable_names[var];
+}
+
+int BinaryRootTask::get_variable_domain_size(int var) const {
+    assert(utils::in_bounds(var, domain_sizes));
+    return domain_sizes[var];
+}
+
+int BinaryRootTask::get_variable_axiom_layer(int var) const {
+    assert(utils::in_bounds(var, axiom_layers));
+    return axiom_layers[var];
+}
+
+int BinaryRootTask::get_variable_default_axiom_value(int var) const {
+    assert(utils::in_bounds(var, axiom_default_values));
+    return axiom_default_values[var];
+}
+
+string BinaryRootTask::get_fact_name(const FactPair &fact) const {
+    return fact_names[get_fact_id(fact)];
+}
+
+bool BinaryRootTask::are_facts_mutex(
+    const FactPair &fact1, const FactPair &fact2) const {
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+    int fact_id = get_fact_id(fact1);
+    int begin = mutexes.get_begin(fact_id);
+    int end = mutexes.get_end(fact_id);
+    while (begin < end) {
+        int middle = begin + (end - begin) / 2;
+        if (mutexes.get_fact(middle) < fact2) {
+            begin = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+    return begin < mutexes.get_end(fact_id) && mutexes.get_fact(begin) == fact2;
+}
+
+int BinaryRootTask::get_operator_cost(int index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    assert(utils::in_bounds(index, actions.costs));
+    return actions.costs[index];
+}
+
+string BinaryRootTask::get_operator_name(int index, bool is_axiom) const {
+    return get_actions(is_axiom).names[index];
+}
+
+int BinaryRootTask::get_num_operators() const {
+    return operators->costs.size();
+}
+
+int BinaryRootTask::get_num_operator_preconditions(int index, bool is_axiom) const {
+    const FactLists &preconditions = get_actions(is_axiom).preconditions;
+    return preconditions.get_end(index) - preconditions.get_begin(index);
+}
+
+FactPair BinaryRootTask::get_operator_precondition(
+    int op_index, int fact_index, bool is_axiom) const {
+    return get_actions(is_axiom).preconditions.get_fact(op_index, fact_index);
+}
+
+int BinaryRootTask::get_num_operator_effects(int op_index, bool is_axiom) const {
+    const FactLists &effects = get_actions(is_axiom).effects;
+    return effects.get_end(op_index) - effects.get_begin(op_index);
+}
+
+int BinaryRootTask::get_num_operator_effect_conditions(
+    int op_index, int eff_index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    int effect = actions.get_effect_index(op_index, eff_index);
+    return actions.effect_conditions.get_end(effect) -
+           actions.effect_conditions.get_begin(effect);
+}
+
+FactPair BinaryRootTask::get_operator_effect_condition(
+    int op_index, int eff_index, int cond_index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    int effect = actions.get_effect_index(op_index, eff_index);
+    return actions.effect_conditions.get_fact(effect, cond_index);
+}
+
+FactPair BinaryRootTask::get_operator_effect(
+    int op_index, int eff_index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    return actions.effects.get_fact(actions.get_effect_index(op_index, eff_index));
+}
+
+int BinaryRootTask::convert_operator_index(
+    int index, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid operator ID conversion");
+    }
+    return index;
+}
+
+int BinaryRootTask::get_num_axioms() const {
+    return axioms->costs.size();
+}
+
+int BinaryRootTask::get_num_goals() const {
+    return goals.get_num_facts();
+}
+
+FactPair BinaryRootTask::get_goal_fact(int index) const {
+    return goals.get_fact(index);
+}
+
+vector<int> BinaryRootTask::get_initial_state_values() const {
+    return vector<int>(initial_state_values.begin(), initial_state_values.end());
+}
+
+void BinaryRootTask::convert_ancestor_state_values(
+    vector<int> &, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion");
+    }
+}
+
 void read_root_task(istream &in) {
     assert(!g_root_task);
-    g_root_task = make_shared<RootTask>(in);
+    in >> ws;
+    if (in.peek() == BINARY_MAGIC[0]) {
+        g_root_task = make_shared<BinaryRootTask>(
+            utils::make_unique_ptr<BinaryTaskData>(in));
+    } else {
+        g_root_task = make_shared<RootTask>(in);
+    }
+}
+
+void read_root_task_from_stdin() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    struct stat file_status;
+    if (cin.peek() == BINARY_MAGIC[0] &&
+        fstat(STDIN_FILENO, &file_status) == 0 &&
+        S_ISREG(file_status.st_mode) && file_status.st_size > 0) {
+        size_t size = file_status.st_size;
+        void *mapped_data = mmap(
+            nullptr, size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+        if (mapped_data != MAP_FAILED) {
+            assert(!g_root_task);
+            g_root_task = make_shared<BinaryRootTask>(
+                utils::make_unique_ptr<BinaryTaskData>(mapped_data, size));
+            return;
+        }
+    }
+#endif
+    read_root_task(cin);
+}
+
+void write_binary_root_task(ostream &out) {
+    if (auto task = dynamic_pointer_cast<RootTask>(g_root_task)) {
+        task->write_binary(out);
+    } else if (auto task = dynamic_pointer_cast<BinaryRootTask>(g_root_task)) {
+        task->write_binary(out);
+    } else {
+        ABORT("Root task has not been read.");
+    }
 }
 
 class RootTaskFeature : public plugins::TypedFeature<AbstractTask, AbstractTask> {
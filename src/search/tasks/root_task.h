@@ -5,6 +5,24 @@
 
 namespace tasks {
 extern std::shared_ptr<AbstractTask> g_root_task;
+
+/*
+  Read the root task from the translator output or from a task written by
+  write_binary_root_task. The format is detected automatically.
+*/
 extern void read_root_task(std::istream &in);
+
+/*
+  Like read_root_task(std::cin), but if the standard input is a regular file
+  containing a task in binary format, the file is memory-mapped and the task
+  is accessed without copying or parsing it.
+*/
+extern void read_root_task_from_stdin();
+
+/*
+  Write the root task in binary format. Reading the binary format is much
+  faster than parsing the translator output, especially for large tasks.
+*/
+extern void write_binary_root_task(std::ostream &out);
 }
 #endif
@@ -6,6 +6,7 @@
 #include "timer.h"
 
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -29,12 +30,16 @@ enum class Verbosity {
   of output. Lines should be eventually terminated by endl. Logs are written to
   stdout.
 
+  Writes are serialized, so threads may share a log. Lines written by
+  different threads at the same time may still interleave.
+
   Internal class encapsulated by LogProxy.
 */
 class Log {
     std::ostream &stream;
     const Verbosity verbosity;
     bool line_has_started;
+    std::mutex mutex;
 
 public:
     explicit Log(Verbosity verbosity)
@@ -43,6 +48,7 @@ public:
 
     template<typename T>
     Log &operator<<(const T &elem) {
+        std::lock_guard<std::mutex> lock(mutex);
         if (!line_has_started) {
             line_has_started = true;
             stream << "[t=" << g_timer << ", "
@@ -55,6 +61,7 @@ public:
 
     using manip_function = std::ostream &(*)(std::ostream &);
     Log &operator<<(manip_function f) {
+        std::lock_guard<std::mutex> lock(mutex);
         if (f == static_cast<manip_function>(&std::endl)) {
             line_has_started = false;
         }
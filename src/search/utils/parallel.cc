@@ -0,0 +1,51 @@
+#include "parallel.h"
+
+#include "system.h"
+
+#include <cassert>
+#include <exception>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace utils {
+static thread_local bool running_in_parallel = false;
+
+void run_in_parallel(int num_threads, const function<void(int)> &work) {
+    assert(num_threads >= 1);
+    vector<exception_ptr> errors(num_threads);
+    auto run = [&](int thread_id) {
+            bool was_running_in_parallel = running_in_parallel;
+            running_in_parallel = true;
+            try {
+                work(thread_id);
+            } catch (...) {
+                errors[thread_id] = current_exception();
+            }
+            running_in_parallel = was_running_in_parallel;
+        };
+    vector<thread> threads;
+    for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+        threads.emplace_back(run, thread_id);
+    }
+    run(0);
+    for (thread &t : threads) {
+        t.join();
+    }
+    for (const exception_ptr &error : errors) {
+        if (error) {
+            try {
+                rethrow_exception(error);
+            } catch (const ExitException &e) {
+                // This throws again if we run in parallel ourselves.
+                exit_with(e.get_exit_code());
+            }
+        }
+    }
+}
+
+bool is_running_in_parallel() {
+    return running_in_parallel;
+}
+}
@@ -0,0 +1,22 @@
+#ifndef UTILS_PARALLEL_H
+#define UTILS_PARALLEL_H
+
+#include <functional>
+
+namespace utils {
+/*
+  Call work(thread_id) for thread_id = 0, ..., num_threads - 1 in parallel
+  and wait until all calls have finished. The call for thread 0 runs in the
+  calling thread. If calls throw exceptions, the exception of the call with
+  the lowest thread ID is rethrown after all calls have finished. Calls of
+  exit_with() in the work throw an ExitException, which is handled the same
+  way. The outermost run_in_parallel() then exits with its exit code.
+*/
+extern void run_in_parallel(
+    int num_threads, const std::function<void(int)> &work);
+
+// Return true if the calling thread runs work of run_in_parallel().
+extern bool is_running_in_parallel();
+}
+
+#endif
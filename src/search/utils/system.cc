@@ -1,5 +1,7 @@
 #include "system.h"
 
+#include "parallel.h"
+
 #include <cstdlib>
 
 using namespace std;
@@ -44,7 +46,15 @@ bool is_exit_code_error_reentrant(ExitCode exitcode) {
     }
 }
 
+ExitException::ExitException(ExitCode exitcode)
+    : Exception("exit requested in parallel work"),
+      exitcode(exitcode) {
+}
+
 void exit_with(ExitCode exitcode) {
+    if (is_running_in_parallel()) {
+        throw ExitException(exitcode);
+    }
     report_exit_code_reentrant(exitcode);
     exit(static_cast<int>(exitcode));
 }
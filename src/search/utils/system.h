@@ -16,6 +16,7 @@
 #include "system_unix.h"
 #endif
 
+#include "exceptions.h"
 #include "language.h"
 
 #include <iostream>
@@ -53,6 +54,22 @@ enum class ExitCode {
     SEARCH_UNSUPPORTED = 34
 };
 
+/*
+  Exception that exit_with() throws instead of exiting the process when it
+  is called in work run by run_in_parallel() (see parallel.h). Exiting
+  there would destroy static objects while other threads still use them,
+  so run_in_parallel() passes the exception on to the calling thread.
+*/
+class ExitException : public Exception {
+    ExitCode exitcode;
+public:
+    explicit ExitException(ExitCode exitcode);
+
+    ExitCode get_exit_code() const {
+        return exitcode;
+    }
+};
+
 NO_RETURN extern void exit_with(ExitCode returncode);
 NO_RETURN extern void exit_after_receiving_signal(ExitCode returncode);
 